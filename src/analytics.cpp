@@ -0,0 +1,240 @@
+#include "simulation.h"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+constexpr long long CHUNK_GAMES = 256;// games per unit of work; small enough to balance, large enough to amortize
+
+// Point is one combination of swept parameters. Chunks of its games are simulated independently and merged.
+struct Point
+{
+  minesweeper::SimulationParameters parameters;
+  std::vector<minesweeper::RoundStats> stats;
+  long long chunks_remaining;
+  std::mutex mutex;
+};
+
+struct Options
+{
+  std::vector<std::pair<int, int>> sizes{ { 18, 30 } };// NOLINT default board size of the terminal game
+  std::vector<int> time_inits{ 20, 30, 40 };// NOLINT magic numbers
+  std::vector<int> time_increments{ 10, 20, 30 };// NOLINT magic numbers
+  std::vector<int> mines_inits{ 5, 10, 20 };// NOLINT magic numbers
+  std::vector<int> mines_increments{ 1, 2, 4 };// NOLINT magic numbers
+  long long games = 10000;// NOLINT magic numbers
+  double seconds_per_move = 0.5;// NOLINT magic numbers
+  int max_rounds = 100;// NOLINT magic numbers
+  unsigned int threads = std::max(1U, std::thread::hardware_concurrency());
+  std::string out = "-";
+};
+
+// Parses a comma-separated list of integers, each at least minimum.
+bool parse_ints(const std::string &text, int minimum, std::vector<int> &values)
+{
+  values.clear();
+  const auto *next = text.data();
+  const auto *end = text.data() + text.size();
+  while (next < end) {
+    int value = 0;
+    auto [ptr, error] = std::from_chars(next, end, value);
+    if (error != std::errc{} || value < minimum) { return false; }
+    values.push_back(value);
+    next = ptr < end && *ptr == ',' ? ptr + 1 : ptr;
+    if (ptr < end && *ptr != ',') { return false; }
+  }
+  return !values.empty();
+}
+
+bool parse_sizes(const std::string &text, std::vector<std::pair<int, int>> &sizes)
+{
+  sizes.clear();
+  std::size_t start = 0;
+  while (start < text.size()) {
+    auto comma = std::min(text.find(',', start), text.size());
+    auto size = text.substr(start, comma - start);
+    auto x = size.find('x');
+    std::vector<int> rows;
+    std::vector<int> columns;
+    if (x == std::string::npos || !parse_ints(size.substr(0, x), 1, rows)
+        || !parse_ints(size.substr(x + 1), 1, columns)) {
+      return false;
+    }
+    sizes.emplace_back(rows.front(), columns.front());
+    start = comma + 1;
+  }
+  return !sizes.empty();
+}
+
+bool parse_int(const std::string &text, long long &value)
+{
+  auto [ptr, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+  return error == std::errc{} && ptr == text.data() + text.size() && value > 0;
+}
+
+// Floating-point from_chars is missing from some standard libraries, so doubles go through strtod.
+bool parse_double(const std::string &text, double &value)
+{
+  char *end = nullptr;
+  value = std::strtod(text.c_str(), &end);
+  return !text.empty() && end == text.c_str() + text.size() && std::isfinite(value) && value > 0;
+}
+
+bool parse_options(const std::vector<std::string> &args, Options &options)
+{
+  if (args.size() % 2 == 0) { return false; }
+  for (std::size_t i = 1; i + 1 < args.size(); i += 2) {
+    const auto &name = args[i];
+    const auto &value = args[i + 1];
+    long long number = 0;
+    if (name == "--size") {
+      if (!parse_sizes(value, options.sizes)) { return false; }
+    } else if (name == "--time-init") {
+      if (!parse_ints(value, 1, options.time_inits)) { return false; }
+    } else if (name == "--time-inc") {
+      if (!parse_ints(value, 0, options.time_increments)) { return false; }
+    } else if (name == "--mines-init") {
+      if (!parse_ints(value, 0, options.mines_inits)) { return false; }
+    } else if (name == "--mines-inc") {
+      if (!parse_ints(value, 0, options.mines_increments)) { return false; }
+    } else if (name == "--games") {
+      if (!parse_int(value, options.games)) { return false; }
+    } else if (name == "--max-rounds") {
+      if (!parse_int(value, number)) { return false; }
+      options.max_rounds = static_cast<int>(number);
+    } else if (name == "--threads") {
+      if (!parse_int(value, number)) { return false; }
+      options.threads = static_cast<unsigned int>(number);
+    } else if (name == "--seconds-per-move") {
+      if (!parse_double(value, options.seconds_per_move)) { return false; }
+    } else if (name == "--out") {
+      options.out = value;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<std::unique_ptr<Point>> sweep(const Options &options)
+{
+  auto chunks = (options.games + CHUNK_GAMES - 1) / CHUNK_GAMES;
+  std::vector<std::unique_ptr<Point>> points;
+  for (auto [rows, columns] : options.sizes) {
+    for (auto time_init : options.time_inits) {
+      for (auto time_increment : options.time_increments) {
+        for (auto mines_init : options.mines_inits) {
+          for (auto mines_increment : options.mines_increments) {
+            auto point = std::make_unique<Point>();
+            point->parameters = { rows,
+              columns,
+              time_init,
+              time_increment,
+              std::min(mines_init, rows * columns),
+              mines_increment,
+              options.seconds_per_move,
+              options.max_rounds };
+            point->chunks_remaining = chunks;
+            points.push_back(std::move(point));
+          }
+        }
+      }
+    }
+  }
+  return points;
+}
+
+void write_header(std::ostream &out)
+{
+  out << "rows,columns,time_init,time_increment,mines_init,mines_increment,round,games,reached,solved,"
+         "survival,mean_solve_seconds,deaths_per_attempt\n";
+}
+
+void write_point(std::ostream &out, const Point &point, long long games)
+{
+  const auto &p = point.parameters;
+  for (std::size_t i = 0; i < point.stats.size(); i++) {
+    const auto &s = point.stats[i];
+    auto survival = static_cast<double>(s.solved) / static_cast<double>(s.reached);
+    auto mean_solve = s.solved > 0 ? s.solve_seconds / static_cast<double>(s.solved) : 0.0;
+    auto deaths = static_cast<double>(s.deaths) / static_cast<double>(s.reached);
+    out << p.rows << ',' << p.columns << ',' << p.time_init << ',' << p.time_increment << ',' << p.mines_init << ','
+        << p.mines_increment << ',' << i + 1 << ',' << games << ',' << s.reached << ',' << s.solved << ','
+        << survival << ',' << mean_solve << ',' << deaths << '\n';
+  }
+  out.flush();
+}
+}// namespace
+
+// Sweeps Game parameters over simulated bot games and writes per-round survival and solve-time statistics as CSV.
+// minesweeper_analytics [--size 9x9,18x30] [--time-init 20,30] [--time-inc 10,20] [--mines-init 5,10]
+//                       [--mines-inc 1,2] [--games N] [--seconds-per-move S] [--max-rounds R] [--threads T] [--out F]
+int main(int argc, const char *argv[])// NOLINT c-style array
+{
+  std::vector<std::string> args{ argv, std::next(argv, argc) };
+  Options options;
+  if (!parse_options(args, options)) {
+    std::cerr << "usage: " << args[0]
+              << " [--size RxC,...] [--time-init N,...] [--time-inc N,...] [--mines-init N,...] [--mines-inc N,...]"
+                 " [--games N] [--seconds-per-move S] [--max-rounds R] [--threads T] [--out FILE]"
+              << std::endl;
+    return 1;
+  }
+
+  std::ofstream file;
+  if (options.out != "-") {
+    file.open(options.out);
+    if (!file.is_open()) {
+      std::cerr << "unable to open " << options.out << std::endl;
+      return 1;
+    }
+  }
+  std::ostream &out = options.out == "-" ? std::cout : file;
+  write_header(out);
+
+  // Units of work are (point, chunk) pairs claimed from a shared cursor, point-major, so that workers finish points
+  // roughly in order and each point is written as soon as its last chunk is merged.
+  auto points = sweep(options);
+  auto chunks = (options.games + CHUNK_GAMES - 1) / CHUNK_GAMES;
+  auto units = static_cast<long long>(points.size()) * chunks;
+  std::atomic<long long> cursor = 0;
+  std::mutex out_mutex;
+
+  auto work = [&] {
+    std::vector<minesweeper::RoundStats> stats;
+    for (auto unit = cursor++; unit < units; unit = cursor++) {
+      auto &point = *points[static_cast<std::size_t>(unit / chunks)];
+      auto chunk = unit % chunks;
+      auto first = chunk * CHUNK_GAMES;
+      auto last = std::min(options.games, first + CHUNK_GAMES);
+      stats.clear();
+      for (auto game = first; game < last; game++) {
+        auto seed = static_cast<unsigned int>(game);// every point plays the same seeds, which sharpens comparisons
+        minesweeper::simulate_game(point.parameters, seed, stats);
+      }
+      std::lock_guard lock{ point.mutex };
+      if (point.stats.size() < stats.size()) { point.stats.resize(stats.size()); }
+      for (std::size_t i = 0; i < stats.size(); i++) { point.stats[i] += stats[i]; }
+      if (--point.chunks_remaining == 0) {
+        std::lock_guard out_lock{ out_mutex };
+        write_point(out, point, options.games);
+        point.stats = {};
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (unsigned int t = 0; t < options.threads; t++) { workers.emplace_back(work); }
+  for (auto &worker : workers) { worker.join(); }
+  return 0;
+}
@@ -5,6 +5,12 @@ Bitmap::Bitmap(int rows_, int columns_)
 {}
 int Bitmap::get_rows() const { return rows; }
 int Bitmap::get_columns() const { return columns; }
+void Bitmap::resize(int rows_, int columns_)
+{
+  rows = rows_;
+  columns = columns_;
+  pixels.resize(static_cast<unsigned int>(rows_ * columns_));
+}
 void Bitmap::set(int row, int col, Pixel pixel) { pixels[static_cast<unsigned int>(row * columns + col)] = pixel; }
 Pixel Bitmap::get(int row, int col) const { return pixels[static_cast<unsigned int>(row * columns + col)]; }
 }// namespace minesweeper
\ No newline at end of file
@@ -16,18 +16,20 @@ struct Pixel
   char value;
 };
 
-// A bitmap is a two-dimensional grid of pixels.
+// A bitmap is a two-dimensional grid of pixels. It can be resized and redrawn in place, so that a bitmap kept
+// from frame to frame does not allocate once it has reached its largest size.
 class Bitmap
 {
 
-  const int rows;
-  const int columns;
+  int rows;
+  int columns;
   std::vector<Pixel> pixels;
 
 public:
   Bitmap(int rows_, int columns_);
   [[nodiscard]] int get_rows() const;
   [[nodiscard]] int get_columns() const;
+  void resize(int rows_, int columns_);
   void set(int row, int col, Pixel pixel);
   [[nodiscard]] Pixel get(int row, int col) const;
 };
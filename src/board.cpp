@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <chrono>
 #include <numeric>
 #include <random>
@@ -5,6 +6,29 @@
 #include "board.h"
 
 namespace minesweeper {
+namespace {
+  // Bit flags of the one-byte-per-cell encoding used to save and restore boards.
+  constexpr std::uint8_t ENCODED_MINE = 1U;
+  constexpr std::uint8_t ENCODED_FLAGGED = 2U;
+  constexpr std::uint8_t ENCODED_REVEALED = 4U;
+
+  unsigned int time_seed()
+  {
+    auto now = std::chrono::system_clock::now();
+    auto second_since_epoch = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
+    return static_cast<unsigned int>(second_since_epoch);
+  }
+}// namespace
+
+Tile read_tile(const Pixel &pixel)
+{
+  if (pixel.value == '*') { return { TileState::flagged, 0 }; }
+  if (pixel.foreground == Color::light_gray) { return { TileState::covered, 0 }; }
+  if (pixel.value >= '1' && pixel.value <= '8') { return { TileState::revealed, pixel.value - '0' }; }
+  if (pixel.foreground == Color::red) { return { TileState::detonated, 0 }; }// after numbers, as 3 is also red
+  return { TileState::revealed, 0 };
+}
+
 void Board::reset()
 {
   for (int row = 0; row < rows; row++) {
@@ -42,13 +66,10 @@ Cell &Board::at(int row, int col) { return cells.at(static_cast<unsigned int>(ro
 
 void Board::assign_mines()
 {
-  auto now = std::chrono::system_clock::now();
-  auto second_since_epoch = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
-  std::mt19937 mt{ static_cast<unsigned int>(second_since_epoch) };
   std::uniform_int_distribution dist{ 0, rows * columns - 1 };// random values over closed (inclusive) range
   int remaining = mines;
   while (remaining > 0) {
-    auto next = dist(mt);
+    auto next = dist(random);
     auto &cell = cells.at(static_cast<unsigned int>(next));
     if (!cell.mine) {
       cell.mine = true;
@@ -89,6 +110,35 @@ void Board::reveal(int row, int col)// NOLINT adjacent int parameters
   if (!cell.mine && cell.adjacentMines == 0) { reveal_neighbors(row, col); }
 }
 
+void Board::reveal_covered_neighbors(int row, int col, ClickResult &result)// NOLINT adjacent int parameters
+{
+  for (int r = std::max(0, row - 1); r <= std::min(rows - 1, row + 1); r++) {
+    for (int c = std::max(0, col - 1); c <= std::min(columns - 1, col + 1); c++) {
+      auto &cell = cells[static_cast<unsigned int>(r * columns + c)];
+      if (!cell.flagged && !cell.revealed) {
+        cell.revealed = true;
+        result.revealed++;
+        pending.push_back(r * columns + c);
+      }
+    }
+  }
+}
+
+// Reveals outward from the pending cells, which are already revealed. A cell is pending only from the moment it is
+// revealed, so flood fills of a batch that overlap stop at each other's tiles rather than visiting them again.
+void Board::flood(ClickResult &result)
+{
+  while (!pending.empty()) {
+    const auto &cell = cells[static_cast<unsigned int>(pending.back())];
+    pending.pop_back();
+    if (cell.mine) {
+      result.alive = false;
+    } else if (cell.adjacentMines == 0) {
+      reveal_covered_neighbors(cell.row, cell.col, result);
+    }
+  }
+}
+
 void Board::render(Bitmap &bitmap, int row, int col) const// NOLINT adjacent int parameters
 {
   const auto &cell = at(row, col);
@@ -109,18 +159,65 @@ void Board::render(Bitmap &bitmap, int row, int col) const// NOLINT adjacent int
 }
 
 Board::Board(int rows_, int columns_, int mines_)// NOLINT adjacent int parameters
-  : rows(rows_), columns(columns_), mines(mines_), cells(static_cast<std::vector<Cell>::size_type>(rows * columns))
+  : Board(rows_, columns_, mines_, time_seed())
+{}
+
+Board::Board(int rows_, int columns_, int mines_, unsigned int seed)// NOLINT adjacent int parameters
+  : rows(rows_), columns(columns_), mines(mines_), cells(static_cast<std::vector<Cell>::size_type>(rows * columns)),
+    random(seed)
 {
   reset();
 }
 
+Board::Board(int rows_, int columns_, int mines_, std::span<const std::uint8_t> encoded)// NOLINT adj int parameters
+  : rows(rows_), columns(columns_), mines(mines_), cells(static_cast<std::vector<Cell>::size_type>(rows * columns)),
+    random(time_seed())
+{
+  for (int row = 0; row < rows; row++) {
+    for (int col = 0; col < columns; col++) {
+      auto &cell = at(row, col);
+      auto bits = encoded[static_cast<unsigned int>(row * columns + col)];
+      cell.row = row;
+      cell.col = col;
+      cell.mine = (bits & ENCODED_MINE) != 0;
+      cell.flagged = (bits & ENCODED_FLAGGED) != 0;
+      cell.revealed = (bits & ENCODED_REVEALED) != 0;
+      cell.adjacentMines = 0;
+    }
+  }
+  assign_adjacent_mines();
+}
+
+void Board::encode(std::span<std::uint8_t> encoded) const
+{
+  for (const auto &cell : cells) {
+    std::uint8_t bits = 0;
+    if (cell.mine) { bits |= ENCODED_MINE; }
+    if (cell.flagged) { bits |= ENCODED_FLAGGED; }
+    if (cell.revealed) { bits |= ENCODED_REVEALED; }
+    encoded[static_cast<unsigned int>(cell.row * columns + cell.col)] = bits;
+  }
+}
+
+int Board::count_encoded_mines(std::span<const std::uint8_t> encoded)
+{
+  return static_cast<int>(
+    std::count_if(encoded.begin(), encoded.end(), [](std::uint8_t bits) { return (bits & ENCODED_MINE) != 0; }));
+}
+
 Bitmap Board::render() const
 {
   auto bitmap = Bitmap(rows, columns);
-  for (const auto &cell : cells) { render(bitmap, cell.row, cell.col); }
+  render(bitmap);
   return bitmap;
 }
 
+void Board::render(Bitmap &bitmap) const
+{
+  bitmap.resize(rows, columns);
+  for (const auto &cell : cells) { render(bitmap, cell.row, cell.col); }
+}
+
 void Board::on_left_click(int row, int col)
 {
   if (is_alive()) {
@@ -145,6 +242,35 @@ void Board::on_right_click(int row, int col)
   }
 }
 
+ClickResult Board::on_clicks(std::span<const Click> clicks)
+{
+  auto fn = [](std::pair<bool, int> state, const Cell &c) {
+    return std::pair{ state.first && !(c.revealed && c.mine), c.revealed ? state.second + 1 : state.second };
+  };
+  auto [alive, revealed] = std::accumulate(cells.cbegin(), cells.cend(), std::pair{ true, 0 }, fn);
+
+  ClickResult result{ 0, 0, alive, false };
+  for (const auto &click : clicks) {
+    if (!result.alive) { break; }
+    result.applied++;
+    auto &cell = at(click.row, click.col);
+    if (cell.revealed && cell.adjacentMines == count_adjacent_flags(click.row, click.col)) {
+      reveal_covered_neighbors(click.row, click.col, result);
+    } else if (click.right) {
+      if (!cell.revealed) { cell.flagged = !cell.flagged; }
+    } else if (!cell.flagged) {
+      if (!cell.revealed) {
+        cell.revealed = true;
+        result.revealed++;
+      }
+      pending.push_back(click.row * columns + click.col);
+    }
+    flood(result);
+  }
+  result.complete = revealed + result.revealed == static_cast<int>(cells.size()) - mines;
+  return result;
+}
+
 void Board::on_hover(int row, int col)// NOLINT adjacent int parameters
 {
   hover_row = row;
@@ -3,8 +3,11 @@
 
 #include "bitmap.h"
 #include <array>
-#include <vector>
+#include <cstdint>
 #include <functional>
+#include <random>
+#include <span>
+#include <vector>
 
 namespace minesweeper {
 
@@ -19,6 +22,38 @@ struct Cell
   int adjacentMines;
 };
 
+// TileState is a cell as a player sees it. Mines stay hidden unless they were revealed.
+enum class TileState { covered, flagged, detonated, revealed };
+
+// Tile is recovered from a rendered pixel, so it carries exactly the information shown to a player.
+struct Tile
+{
+  TileState state;
+  int adjacentMines;
+
+  bool operator==(const Tile &) const = default;
+};
+
+[[nodiscard]] Tile read_tile(const Pixel &pixel);
+
+// Click is one left or right click in a batch of clicks applied to a board.
+struct Click
+{
+  int row;
+  int col;
+  bool right;
+};
+
+// ClickResult summarizes a batch of clicks: how many were applied, how many tiles they revealed, and the state of the
+// board afterwards. A batch ends at the first click that detonates a mine, which is the last one applied.
+struct ClickResult
+{
+  std::size_t applied;
+  int revealed;
+  bool alive;
+  bool complete;
+};
+
 // Board is a two-dimensional grid of cells. It can be rendered as a bitmap.
 class Board
 {
@@ -39,6 +74,10 @@ class Board
 
   std::vector<Cell> cells;
 
+  std::mt19937 random;
+
+  std::vector<int> pending;// cells revealed by a batch whose neighbors are yet to be visited
+
   int hover_row = -1;
   int hover_col = -1;
 
@@ -51,13 +90,24 @@ class Board
   int count_adjacent_flags(int row, int col);
   void reveal_neighbors(int row, int col);
   void reveal(int row, int col);
+  void reveal_covered_neighbors(int row, int col, ClickResult &result);
+  void flood(ClickResult &result);
   void render(Bitmap &bitmap, int row, int col) const;
 
 public:
   explicit Board(int rows_, int columns_, int mines_);
+  explicit Board(int rows_, int columns_, int mines_, unsigned int seed);
+  explicit Board(int rows_, int columns_, int mines_, std::span<const std::uint8_t> encoded);
+  void encode(std::span<std::uint8_t> encoded) const;
+  // Returns the number of mines in an encoding, so that it can be checked before a board is built from it.
+  [[nodiscard]] static int count_encoded_mines(std::span<const std::uint8_t> encoded);
   [[nodiscard]] Bitmap render() const;
+  void render(Bitmap &bitmap) const;
   void on_left_click(int row, int col);
   void on_right_click(int row, int col);
+  // Applies clicks in order, with the same effect as the single click events, but checks the state of the board once
+  // per batch rather than once per click.
+  ClickResult on_clicks(std::span<const Click> clicks);
   void on_key_up();
   void on_hover(int row, int col);
   void restore();
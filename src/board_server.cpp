@@ -0,0 +1,242 @@
+#include "board_server.h"
+#include "net.h"
+#include <array>
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <utility>
+
+namespace minesweeper {
+namespace {
+  constexpr int REFRESH_MS = 100;// the game clock is checked at least this often
+  constexpr std::size_t MAX_EVENTS = 256;
+  constexpr std::size_t READ_SIZE = 1U << 16U;
+
+  bool same(const Status &a, const Status &b) { return a.round == b.round && a.time == b.time && a.mines == b.mines; }
+
+  bool would_block() { return errno == EAGAIN; }// the same value as EWOULDBLOCK on Linux
+}// namespace
+
+BoardServer::BoardServer(Game game_, int listen_fd_, int epoll_fd_, int wake_fd_)// NOLINT adj int parameters
+  : game(std::move(game_)), listen_fd(listen_fd_), epoll_fd(epoll_fd_), wake_fd(wake_fd_),
+    bound_address(local_address(listen_fd_)), published(game.render_board()), published_status(status())
+{}
+
+std::unique_ptr<BoardServer> BoardServer::listen(const std::string &address, Game game)
+{
+  auto listen_fd = listen_on(address);
+  if (listen_fd < 0) { return nullptr; }
+  auto epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+  auto wake_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  epoll_event event{};
+  event.events = EPOLLIN;
+  event.data.fd = listen_fd;
+  auto listening = epoll_fd >= 0 && ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &event) == 0;
+  event.data.fd = wake_fd;
+  auto waking = wake_fd >= 0 && ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &event) == 0;
+  if (!listening || !waking) {
+    for (auto fd : { listen_fd, epoll_fd, wake_fd }) {
+      if (fd >= 0) { ::close(fd); }
+    }
+    return nullptr;
+  }
+  return std::unique_ptr<BoardServer>(new BoardServer(std::move(game), listen_fd, epoll_fd, wake_fd));// NOLINT
+}
+
+BoardServer::~BoardServer()
+{
+  for (const auto &entry : connections) { ::close(entry.first); }
+  ::close(listen_fd);
+  ::close(epoll_fd);
+  ::close(wake_fd);
+  if (bound_address.starts_with("unix:")) { ::unlink(bound_address.substr(5).c_str()); }// NOLINT prefix length
+}
+
+std::string BoardServer::address() const { return bound_address; }
+
+Status BoardServer::status() const { return { game.get_round(), game.get_time(), game.get_mines() }; }
+
+void BoardServer::run()
+{
+  std::array<epoll_event, MAX_EVENTS> events{};
+  bool stopping = false;
+  while (!stopping) {
+    auto count = ::epoll_wait(epoll_fd, events.data(), static_cast<int>(events.size()), REFRESH_MS);
+    if (count < 0 && errno != EINTR) { return; }
+    for (int i = 0; i < count; i++) {
+      const auto &event = events.at(static_cast<unsigned int>(i));
+      auto fd = event.data.fd;
+      if (fd == wake_fd) {
+        stopping = true;
+      } else if (fd == listen_fd) {
+        accept_clients();
+      } else if (auto it = connections.find(fd); it != connections.end()) {
+        if ((event.events & (EPOLLHUP | EPOLLERR)) != 0) {
+          closing.push_back(fd);
+          continue;
+        }
+        if ((event.events & EPOLLIN) != 0) { read_client(fd, it->second); }
+        if ((event.events & EPOLLOUT) != 0) { flush(fd, it->second); }
+      }
+    }
+    game.on_refresh_event();
+    broadcast();
+    for (auto fd : closing) { close_client(fd); }
+    closing.clear();
+  }
+}
+
+void BoardServer::stop()
+{
+  std::uint64_t one = 1;
+  [[maybe_unused]] auto written = ::write(wake_fd, &one, sizeof(one));
+}
+
+void BoardServer::accept_clients()
+{
+  while (true) {
+    auto fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0) { return; }
+    set_nodelay(fd);
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLRDHUP;
+    event.data.fd = fd;
+    if (::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+      ::close(fd);
+      continue;
+    }
+    auto &connection = connections[fd];
+    encode_board(connection.out, published_status, published);// later diffs are relative to the published board
+    flush(fd, connection);
+  }
+}
+
+// Reads at most one chunk per wakeup, so that a client that keeps its socket full takes its turn with the others.
+// Epoll is level-triggered and reports the client again while input remains.
+void BoardServer::read_client(int fd, Connection &connection)
+{
+  std::array<std::uint8_t, READ_SIZE> buffer{};
+  auto received = ::recv(fd, buffer.data(), buffer.size(), 0);
+  while (received < 0 && errno == EINTR) { received = ::recv(fd, buffer.data(), buffer.size(), 0); }
+  if (received <= 0) {
+    if (received == 0 || !would_block()) { closing.push_back(fd); }
+    return;
+  }
+  connection.reader.append(std::span{ buffer }.first(static_cast<std::size_t>(received)));
+  while (auto payload = connection.reader.next()) {
+    auto move = decode_move(*payload);
+    if (!move) {
+      closing.push_back(fd);
+      return;
+    }
+    apply(fd, connection, *move);
+  }
+  if (connection.reader.is_corrupt() || connection.reader.get_buffered() > MAX_UNPARSED) { closing.push_back(fd); }
+}
+
+void BoardServer::apply(int fd, Connection &connection, const Move &move)
+{
+  if (move.action == Action::left_click) {
+    game.on_mouse_event(move.row, move.col, true, false, true);
+  } else if (move.action == Action::right_click) {
+    game.on_mouse_event(move.row, move.col, false, true, true);
+  } else if (move.action == Action::new_game) {
+    game.on_new_game();
+  } else {
+    game.on_reset_game();
+  }
+  if (connection.acks.empty()) { acked.push_back(fd); }
+  connection.acks.push_back(move.seq);
+}
+
+// Sends one diff covering every move applied since the last broadcast, followed by each mover's acks.
+// Encoding the diff once and queueing the same bytes to every client keeps a broadcast linear in clients.
+void BoardServer::broadcast()
+{
+  game.on_mouse_event(-1, -1, false, false, false);// the shared board has no hover; clients draw their own
+  game.render_board(current);
+  auto current_status = status();
+  updates.clear();
+  diff_bitmaps(published, current, updates);
+  auto changed = !updates.empty() || !same(current_status, published_status);
+  if (changed) {
+    for (const auto &update : updates) { published.set(update.row, update.col, update.pixel); }
+    published_status = current_status;
+    frame.clear();
+    encode_diff(frame, current_status, updates);
+    for (auto &[fd, connection] : connections) {
+      queue(fd, connection, frame);
+      if (connection.acks.empty()) { flush(fd, connection); }
+    }
+  }
+  for (auto fd : acked) {
+    if (auto it = connections.find(fd); it != connections.end()) {
+      auto &connection = it->second;
+      for (auto seq : connection.acks) { encode_ack(connection.out, seq); }
+      connection.acks.clear();
+      flush(fd, connection);
+    }
+  }
+  acked.clear();
+}
+
+// A client that keeps draining its socket but never catches up fully still has its sent prefix erased, once that
+// prefix is at least as long as the unsent rest, so the buffer stays within about twice MAX_QUEUED.
+void BoardServer::queue(int fd, Connection &connection, std::span<const std::uint8_t> bytes)
+{
+  auto unsent = connection.out.size() - connection.out_start;
+  if (unsent > MAX_QUEUED) {
+    closing.push_back(fd);
+    return;
+  }
+  if (connection.out_start > 0 && connection.out_start >= unsent) {
+    auto sent = connection.out.begin() + static_cast<std::ptrdiff_t>(connection.out_start);
+    connection.out.erase(connection.out.begin(), sent);
+    connection.out_start = 0;
+  }
+  connection.out.insert(connection.out.end(), bytes.begin(), bytes.end());
+}
+
+void BoardServer::flush(int fd, Connection &connection)
+{
+  while (connection.out_start < connection.out.size()) {
+    auto pending = std::span{ connection.out }.subspan(connection.out_start);
+    auto sent = ::send(fd, pending.data(), pending.size(), MSG_NOSIGNAL);
+    if (sent > 0) {
+      connection.out_start += static_cast<std::size_t>(sent);
+    } else {
+      if (sent < 0 && would_block()) {
+        if (!connection.writable_wait) {// resume when the socket drains
+          epoll_event event{};
+          event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP;
+          event.data.fd = fd;
+          ::epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &event);
+          connection.writable_wait = true;
+        }
+      } else {
+        closing.push_back(fd);
+      }
+      return;
+    }
+  }
+  connection.out.clear();
+  connection.out_start = 0;
+  if (connection.writable_wait) {
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLRDHUP;
+    event.data.fd = fd;
+    ::epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &event);
+    connection.writable_wait = false;
+  }
+}
+
+void BoardServer::close_client(int fd)
+{
+  if (connections.erase(fd) > 0) {
+    ::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+  }
+}
+}// namespace minesweeper
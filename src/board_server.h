@@ -0,0 +1,73 @@
+#ifndef MINESWEEPER_BOARD_SERVER
+#define MINESWEEPER_BOARD_SERVER
+
+#include "game.h"
+#include "protocol.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace minesweeper {
+
+// BoardServer shares one authoritative game among many clients. A single epoll loop applies client moves in
+// arrival order and then broadcasts the tiles they changed, so every client observes the same sequence of states.
+class BoardServer
+{
+  // Connection is the per-client stream state. Output that the socket did not accept stays queued in out.
+  struct Connection
+  {
+    FrameReader reader;
+    std::vector<std::uint8_t> out;
+    std::size_t out_start = 0;
+    std::vector<std::uint32_t> acks;
+    bool writable_wait = false;
+  };
+
+  static constexpr std::size_t MAX_QUEUED = 1U << 22U;// a client this far behind is dropped
+  static constexpr std::size_t MAX_UNPARSED = 1U << 16U;// no move frame is this long, so such input is dropped
+
+  Game game;
+  const int listen_fd;
+  const int epoll_fd;
+  const int wake_fd;
+  const std::string bound_address;
+
+  std::unordered_map<int, Connection> connections;
+  std::vector<int> acked;
+  std::vector<int> closing;
+
+  Bitmap published;
+  Bitmap current{ 0, 0 };
+  Status published_status;
+  std::vector<CellUpdate> updates;
+  std::vector<std::uint8_t> frame;
+
+  [[nodiscard]] Status status() const;
+  void accept_clients();
+  void read_client(int fd, Connection &connection);
+  void apply(int fd, Connection &connection, const Move &move);
+  void broadcast();
+  void flush(int fd, Connection &connection);
+  void queue(int fd, Connection &connection, std::span<const std::uint8_t> bytes);
+  void close_client(int fd);
+
+  BoardServer(Game game_, int listen_fd_, int epoll_fd_, int wake_fd_);
+
+public:
+  // Returns nullptr if the address cannot be bound.
+  [[nodiscard]] static std::unique_ptr<BoardServer> listen(const std::string &address, Game game);
+  BoardServer(const BoardServer &) = delete;
+  BoardServer(BoardServer &&) = delete;
+  BoardServer &operator=(const BoardServer &) = delete;
+  BoardServer &operator=(BoardServer &&) = delete;
+  ~BoardServer();
+  [[nodiscard]] std::string address() const;
+  // Serves clients until stop is called. Stop may be called from any thread.
+  void run();
+  void stop();
+};
+}// namespace minesweeper
+
+#endif
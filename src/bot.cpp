@@ -0,0 +1,87 @@
+#include "bot.h"
+#include <algorithm>
+
+namespace minesweeper {
+namespace {
+  // Boards and bots are often given the same seed. Both draw cells from the same range, so an unmixed seed would
+  // make the bot's guesses follow the mine placement.
+  std::mt19937 bot_random(unsigned int seed)
+  {
+    std::seed_seq sequence{ seed, 0x626f74U };// NOLINT arbitrary stream constant, "bot" in ASCII
+    return std::mt19937{ sequence };
+  }
+}// namespace
+
+Bot::Bot(unsigned int seed) : random(bot_random(seed)) {}
+
+void Bot::choose(int row, int col, bool flag)
+{
+  auto &mark = chosen.at(static_cast<unsigned int>(row * columns + col));
+  if (mark == 0) {
+    mark = 1;
+    moves.push_back({ row, col, flag });
+  }
+}
+
+const std::vector<BotMove> &Bot::next(const Bitmap &bitmap)
+{
+  auto rows = bitmap.get_rows();
+  columns = bitmap.get_columns();
+  moves.clear();
+  chosen.assign(static_cast<unsigned int>(rows * columns), 0);
+
+  tiles.clear();
+  for (int r = 0; r < rows; r++) {
+    for (int c = 0; c < columns; c++) { tiles.push_back(read_tile(bitmap.get(r, c))); }
+  }
+  auto tile = [&](int r, int c) { return tiles[static_cast<unsigned int>(r * columns + c)]; };
+
+  for (auto index : known_mines) {
+    if (tile(index / columns, index % columns).state == TileState::covered) {
+      choose(index / columns, index % columns, true);
+    }
+  }
+
+  for (int r = 0; r < rows; r++) {
+    for (int c = 0; c < columns; c++) {
+      auto center = tile(r, c);
+      if (center.state != TileState::revealed || center.adjacentMines == 0) { continue; }
+      int covered = 0;
+      int flagged = 0;
+      for (int ar = std::max(r - 1, 0); ar <= std::min(r + 1, rows - 1); ar++) {
+        for (int ac = std::max(c - 1, 0); ac <= std::min(c + 1, columns - 1); ac++) {
+          auto state = tile(ar, ac).state;
+          if (state == TileState::covered) { covered++; }
+          if (state == TileState::flagged) { flagged++; }
+        }
+      }
+      if (covered == 0 || (flagged != center.adjacentMines && flagged + covered != center.adjacentMines)) {
+        continue;
+      }
+      auto flag = flagged != center.adjacentMines;
+      for (int ar = std::max(r - 1, 0); ar <= std::min(r + 1, rows - 1); ar++) {
+        for (int ac = std::max(c - 1, 0); ac <= std::min(c + 1, columns - 1); ac++) {
+          if (tile(ar, ac).state == TileState::covered) { choose(ar, ac, flag); }
+        }
+      }
+    }
+  }
+
+  if (moves.empty()) {// no rule applies, so guess among the covered tiles
+    std::vector<int> covered;
+    for (int i = 0; i < rows * columns; i++) {
+      if (tiles[static_cast<unsigned int>(i)].state == TileState::covered) { covered.push_back(i); }
+    }
+    if (!covered.empty()) {
+      std::uniform_int_distribution<std::size_t> dist{ 0, covered.size() - 1 };
+      auto index = covered[dist(random)];
+      choose(index / columns, index % columns, false);
+    }
+  }
+  return moves;
+}
+
+void Bot::on_detonation(int row, int col) { known_mines.push_back(row * columns + col); }
+
+void Bot::on_new_board() { known_mines.clear(); }
+}// namespace minesweeper
@@ -0,0 +1,42 @@
+#ifndef MINESWEEPER_BOT
+#define MINESWEEPER_BOT
+
+#include "board.h"
+#include <random>
+#include <vector>
+
+namespace minesweeper {
+
+// BotMove is a single click chosen by a bot.
+struct BotMove
+{
+  int row;
+  int col;
+  bool flag;
+};
+
+// Bot plays a board the way a person would: it sees only the rendered tiles. It applies the single-tile rules
+// (a number whose flags are satisfied clears its neighbors; a number with as many covered neighbors as missing
+// mines flags them) and guesses at random when no rule applies. Mines it has detonated are remembered and flagged
+// after the board is reset.
+class Bot
+{
+  std::mt19937 random;
+  std::vector<Tile> tiles;
+  std::vector<BotMove> moves;
+  std::vector<char> chosen;
+  std::vector<int> known_mines;
+  int columns = 0;
+
+  void choose(int row, int col, bool flag);
+
+public:
+  explicit Bot(unsigned int seed);
+  // Returns the next batch of moves for the board shown in the bitmap, or no moves if nothing is left to click.
+  [[nodiscard]] const std::vector<BotMove> &next(const Bitmap &bitmap);
+  void on_detonation(int row, int col);
+  void on_new_board();
+};
+}// namespace minesweeper
+
+#endif
@@ -1,5 +1,6 @@
 #include "game.h"
 #include <iostream>
+#include <utility>
 
 namespace minesweeper {
 std::chrono::time_point<std::chrono::steady_clock, std::chrono::milliseconds> Game::time_now()
@@ -18,6 +19,31 @@ Game::Game(int rows_, int cols_, int time_init_, int time_inc_, int mines_init_,
     board(rows_, cols_, mines_init_), time(time_init)
 {}
 
+Game::Game(const GameSnapshot &snapshot, Board board_)
+  : time_init(snapshot.time_init), time_increment(snapshot.time_increment), mines_init(snapshot.mines_init),
+    mines_increment(snapshot.mines_increment), board(std::move(board_)), state(static_cast<GameState>(snapshot.state)),
+    round(snapshot.round), time(snapshot.time),
+    start_time(time_now() - std::chrono::milliseconds{ snapshot.elapsed_ms })// resume the clock where it stopped
+{}
+
+GameSnapshot Game::snapshot() const
+{
+  std::int64_t elapsed_ms = 0;
+  if (state == GameState::playing) {
+    elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(time_now() - start_time).count();
+  }
+  return { time_init,
+    time_increment,
+    mines_init,
+    mines_increment,
+    static_cast<int>(state),
+    round,
+    time,
+    elapsed_ms };
+}
+
+const Board &Game::get_board() const { return board; }
+
 int Game::get_round() const { return round; }
 
 int Game::get_time() const
@@ -80,6 +106,7 @@ void Game::on_reset_game()
 }
 
 Bitmap Game::render_board() const { return board.render(); }
+void Game::render_board(Bitmap &bitmap) const { board.render(bitmap); }
 void Game::on_key_up()
 {
   if (state != GameState::ended) { board.on_key_up(); }
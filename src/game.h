@@ -3,13 +3,28 @@
 
 #include "board.h"
 #include <chrono>
+#include <cstdint>
 
 namespace minesweeper {
 
+// GameSnapshot captures the game state outside of the board, so that a game can be saved and later resumed.
+struct GameSnapshot
+{
+  int time_init;
+  int time_increment;
+  int mines_init;
+  int mines_increment;
+  int state;
+  int round;
+  int time;
+  std::int64_t elapsed_ms;
+};
+
+
 // Game models the overall game state, including the board, timer, and button interactions.
 class Game
 {
-  enum class GameState { init, playing, ended };
+  enum class GameState { init = 0, playing = 1, ended = 2 };
 
   const int time_init;
   const int time_increment;
@@ -28,6 +43,9 @@ class Game
 
 public:
   Game(int rows_, int cols_, int time_init_, int time_inc_, int mines_init_, int mines_inc_);
+  Game(const GameSnapshot &snapshot, Board board_);
+  [[nodiscard]] GameSnapshot snapshot() const;
+  [[nodiscard]] const Board &get_board() const;
   [[nodiscard]] int get_round() const;
   [[nodiscard]] int get_time() const;
   [[nodiscard]] int get_mines() const;
@@ -37,6 +55,7 @@ public:
   void on_new_game();
   void on_reset_game();
   [[nodiscard]] Bitmap render_board() const;
+  void render_board(Bitmap &bitmap) const;
 };
 }// namespace minesweeper
 
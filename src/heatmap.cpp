@@ -0,0 +1,396 @@
+#include "heatmap.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace minesweeper {
+namespace {
+  constexpr long ENUMERATION_BUDGET = 1L << 20;// search steps per component before it is estimated instead
+
+  // Constraint is a revealed number: exactly `remaining` of its covered neighbors are mines.
+  struct Constraint
+  {
+    int remaining;
+    std::vector<int> cells;
+  };
+
+  // Search counts the mine arrangements of one component by backtracking over its cells in row-major order, which
+  // keeps the cells of each constraint close together so that infeasible branches are cut early.
+  struct Search
+  {
+    std::vector<std::vector<std::size_t>> cell_constraints;
+    std::vector<int> required;// mines still needed by each constraint
+    std::vector<int> open;// cells not yet assigned in each constraint
+    std::vector<char> mine;
+    std::vector<double> weights;
+    std::vector<double> cell_weights;
+    long steps = 0;
+    int placed = 0;
+
+    bool assign(std::size_t cell);
+  };
+
+  // Returns false once the search has run out of budget.
+  bool Search::assign(std::size_t cell)
+  {
+    if (++steps > ENUMERATION_BUDGET) { return false; }
+    auto count = mine.size();
+    if (cell == count) {
+      auto k = static_cast<std::size_t>(placed);
+      weights[k] += 1;
+      for (std::size_t i = 0; i < count; i++) {
+        if (mine[i] != 0) { cell_weights[k * count + i] += 1; }
+      }
+      return true;
+    }
+    for (int value = 0; value <= 1; value++) {
+      auto feasible = std::all_of(cell_constraints[cell].cbegin(), cell_constraints[cell].cend(), [&](auto c) {
+        auto need = required[c] - value;
+        return need >= 0 && need <= open[c] - 1;
+      });
+      if (!feasible) { continue; }
+      for (auto c : cell_constraints[cell]) {
+        required[c] -= value;
+        open[c]--;
+      }
+      mine[cell] = static_cast<char>(value);
+      placed += value;
+      auto within_budget = assign(cell + 1);
+      for (auto c : cell_constraints[cell]) {
+        required[c] += value;
+        open[c]++;
+      }
+      mine[cell] = 0;
+      placed -= value;
+      if (!within_budget) { return false; }
+    }
+    return true;
+  }
+
+  // Convolves two mine-count distributions, scaled so that the largest weight is 1. Only ratios between weights
+  // matter, and the scaling keeps products of many components within the range of a double.
+  std::vector<double> convolve(const std::vector<double> &a, const std::vector<double> &b)
+  {
+    std::vector<double> result(a.size() + b.size() - 1, 0.0);
+    for (std::size_t i = 0; i < a.size(); i++) {
+      for (std::size_t j = 0; j < b.size(); j++) { result[i + j] += a[i] * b[j]; }
+    }
+    auto largest = *std::max_element(result.cbegin(), result.cend());
+    if (largest > 0) {
+      for (auto &weight : result) { weight /= largest; }
+    }
+    return result;
+  }
+
+  double log_binomial(int n, int k)
+  {
+    return std::lgamma(n + 1.0) - std::lgamma(k + 1.0) - std::lgamma(n - k + 1.0);
+  }
+}// namespace
+
+void ProbabilitySolver::solve(std::span<const Tile> tiles,
+  int rows,
+  int columns,
+  int mines,
+  std::vector<float> &probabilities)
+{
+  auto count = static_cast<std::size_t>(rows * columns);
+  probabilities.assign(count, UNKNOWN_PROBABILITY);
+  enumerated = 0;
+  next_cache.clear();
+
+  int flags = 0;
+  int covered = 0;
+  for (const auto &tile : tiles) {
+    if (tile.state == TileState::detonated) { return; }
+    if (tile.state == TileState::flagged) { flags++; }
+    if (tile.state == TileState::covered) { covered++; }
+  }
+
+  // Every revealed tile constrains its covered neighbors. Constraints are numbered in row-major order of their tiles.
+  std::vector<Constraint> constraints;
+  std::vector<std::vector<std::size_t>> cell_constraints(count);
+  for (int row = 0; row < rows; row++) {
+    for (int col = 0; col < columns; col++) {
+      const auto &tile = tiles[static_cast<std::size_t>(row * columns + col)];
+      if (tile.state != TileState::revealed) { continue; }
+      Constraint constraint{ tile.adjacentMines, {} };
+      for (int r = std::max(0, row - 1); r <= std::min(rows - 1, row + 1); r++) {
+        for (int c = std::max(0, col - 1); c <= std::min(columns - 1, col + 1); c++) {
+          auto state = tiles[static_cast<std::size_t>(r * columns + c)].state;
+          if (state == TileState::flagged) { constraint.remaining--; }
+          if (state == TileState::covered) { constraint.cells.push_back(r * columns + c); }
+        }
+      }
+      if (constraint.remaining < 0 || constraint.remaining > static_cast<int>(constraint.cells.size())) {
+        return;// a flag contradicts the numbers, so no arrangement of mines explains the board
+      }
+      if (constraint.cells.empty()) { continue; }
+      for (auto cell : constraint.cells) {
+        cell_constraints[static_cast<std::size_t>(cell)].push_back(constraints.size());
+      }
+      constraints.push_back(std::move(constraint));
+    }
+  }
+
+  // Split the frontier into components of cells linked by shared constraints, and solve each one that is not cached.
+  std::vector<const Solution *> solutions;
+  std::vector<char> visited(count, 0);
+  std::vector<char> constraint_visited(constraints.size(), 0);
+  std::vector<int> queue;
+  int frontier = 0;
+  for (std::size_t start = 0; start < count; start++) {
+    if (cell_constraints[start].empty() || visited[start] != 0) { continue; }
+    std::vector<int> cells;
+    std::vector<std::size_t> ids;
+    queue.assign(1, static_cast<int>(start));
+    visited[start] = 1;
+    while (!queue.empty()) {
+      auto cell = queue.back();
+      queue.pop_back();
+      cells.push_back(cell);
+      for (auto id : cell_constraints[static_cast<std::size_t>(cell)]) {
+        if (constraint_visited[id] != 0) { continue; }
+        constraint_visited[id] = 1;
+        ids.push_back(id);
+        for (auto next : constraints[id].cells) {
+          if (visited[static_cast<std::size_t>(next)] == 0) {
+            visited[static_cast<std::size_t>(next)] = 1;
+            queue.push_back(next);
+          }
+        }
+      }
+    }
+    std::sort(cells.begin(), cells.end());
+    std::sort(ids.begin(), ids.end());
+    frontier += static_cast<int>(cells.size());
+
+    // The constraints, with their cells, identify the component and determine its solution.
+    std::vector<int> key;
+    for (auto id : ids) {
+      key.push_back(constraints[id].remaining);
+      key.push_back(static_cast<int>(constraints[id].cells.size()));
+      key.insert(key.end(), constraints[id].cells.cbegin(), constraints[id].cells.cend());
+    }
+    if (auto node = cache.extract(key)) {
+      solutions.push_back(&next_cache.insert(std::move(node)).position->second);
+      continue;
+    }
+
+    enumerated++;
+    Search search;
+    auto size = cells.size();
+    auto local = [&cells](int cell) {
+      return static_cast<std::size_t>(std::lower_bound(cells.cbegin(), cells.cend(), cell) - cells.cbegin());
+    };
+    search.cell_constraints.resize(size);
+    for (std::size_t i = 0; i < ids.size(); i++) {
+      search.required.push_back(constraints[ids[i]].remaining);
+      search.open.push_back(static_cast<int>(constraints[ids[i]].cells.size()));
+      for (auto cell : constraints[ids[i]].cells) { search.cell_constraints[local(cell)].push_back(i); }
+    }
+    search.mine.assign(size, 0);
+    search.weights.assign(size + 1, 0.0);
+    search.cell_weights.assign((size + 1) * size, 0.0);
+
+    Solution solution;
+    if (search.assign(0)) {
+      while (!search.weights.empty() && search.weights.back() == 0) { search.weights.pop_back(); }
+      if (search.weights.empty()) { return; }// no arrangement of mines satisfies the numbers
+      search.cell_weights.resize(search.weights.size() * size);
+      solution.weights = std::move(search.weights);
+      solution.cell_weights = std::move(search.cell_weights);
+    } else {// too many arrangements: a number that is already satisfied or saturated decides its cells, and other
+            // cells take the average density of their numbers
+      for (std::size_t i = 0; i < size; i++) {
+        double sum = 0;
+        bool safe = false;
+        bool mine = false;
+        for (auto c : search.cell_constraints[i]) {
+          auto density = static_cast<double>(search.required[c]) / search.open[c];
+          safe = safe || density == 0;
+          mine = mine || density == 1;
+          sum += density;
+        }
+        auto estimate = sum / static_cast<double>(search.cell_constraints[i].size());
+        solution.estimates.push_back(static_cast<float>(safe ? 0.0 : (mine ? 1.0 : estimate)));
+      }
+    }
+    solution.cells = std::move(cells);
+    solutions.push_back(&next_cache.emplace(std::move(key), std::move(solution)).first->second);
+  }
+  cache.swap(next_cache);
+
+  // Estimated components take their expected number of mines out of the total. Exact components are weighed by the
+  // number of ways the remaining mines can be placed among the tiles that no number constrains.
+  auto remaining = mines - flags;
+  auto unconstrained = covered - frontier;
+  std::vector<const Solution *> exact;
+  double expected = 0;
+  for (const auto *solution : solutions) {
+    if (solution->estimates.empty()) {
+      exact.push_back(solution);
+      continue;
+    }
+    for (std::size_t i = 0; i < solution->cells.size(); i++) {
+      probabilities[static_cast<std::size_t>(solution->cells[i])] = solution->estimates[i];
+      expected += static_cast<double>(solution->estimates[i]);
+    }
+  }
+  remaining = std::max(0, remaining - static_cast<int>(std::lround(expected)));
+
+  auto n = exact.size();
+  std::vector<std::vector<double>> prefix(n + 1, std::vector<double>{ 1.0 });
+  std::vector<std::vector<double>> suffix(n + 1, std::vector<double>{ 1.0 });
+  for (std::size_t i = 0; i < n; i++) { prefix[i + 1] = convolve(prefix[i], exact[i]->weights); }
+  for (std::size_t i = n; i > 0; i--) { suffix[i - 1] = convolve(exact[i - 1]->weights, suffix[i]); }
+
+  // Weight of placing the rest of the mines, x of them, among the unconstrained tiles, relative to the largest such
+  // weight that can occur.
+  const auto &all = prefix[n];
+  double largest = -HUGE_VAL;
+  for (std::size_t k = 0; k < all.size(); k++) {
+    auto x = remaining - static_cast<int>(k);
+    if (x >= 0 && x <= unconstrained) { largest = std::max(largest, log_binomial(unconstrained, x)); }
+  }
+  auto rest = [&](int x) {
+    return x >= 0 && x <= unconstrained ? std::exp(log_binomial(unconstrained, x) - largest) : 0.0;
+  };
+
+  double total = 0;
+  double unconstrained_mines = 0;
+  for (std::size_t k = 0; k < all.size(); k++) {
+    auto x = remaining - static_cast<int>(k);
+    total += all[k] * rest(x);
+    unconstrained_mines += all[k] * rest(x) * x;
+  }
+  if (total <= 0) { return; }// the mine count cannot be reconciled with the numbers
+  if (unconstrained > 0) {
+    auto probability = static_cast<float>(unconstrained_mines / total / unconstrained);
+    for (std::size_t cell = 0; cell < count; cell++) {
+      if (tiles[cell].state == TileState::covered && cell_constraints[cell].empty()) {
+        probabilities[cell] = probability;
+      }
+    }
+  }
+
+  for (std::size_t i = 0; i < n; i++) {
+    const auto &solution = *exact[i];
+    auto others = convolve(prefix[i], suffix[i + 1]);
+    auto size = solution.cells.size();
+    double weight = 0;
+    std::vector<double> cell_weight(size, 0.0);
+    for (std::size_t k = 0; k < solution.weights.size(); k++) {
+      double ways = 0;
+      for (std::size_t j = 0; j < others.size(); j++) {
+        ways += others[j] * rest(remaining - static_cast<int>(k + j));
+      }
+      weight += solution.weights[k] * ways;
+      for (std::size_t c = 0; c < size; c++) { cell_weight[c] += solution.cell_weights[k * size + c] * ways; }
+    }
+    if (weight <= 0) { continue; }
+    for (std::size_t c = 0; c < size; c++) {
+      probabilities[static_cast<std::size_t>(solution.cells[c])] = static_cast<float>(cell_weight[c] / weight);
+    }
+  }
+}
+
+int ProbabilitySolver::get_enumerated() const { return enumerated; }
+
+Heatmap::Heatmap(std::function<void()> on_publish_) : on_publish(std::move(on_publish_)), worker([this] { run(); })
+{}
+
+Heatmap::~Heatmap()
+{
+  stopping = true;
+  submitted++;
+  submitted.notify_one();
+  worker.join();
+}
+
+void Heatmap::run()
+{
+  ProbabilitySolver solver;
+  std::uint32_t seen = 0;
+  while (true) {
+    submitted.wait(seen);
+    seen = submitted.load();
+    if (stopping) { return; }
+    if (!input.refresh()) { continue; }// already solved by an earlier pass
+    const auto &next = input.read_buffer();
+    auto &result = output.write_buffer();
+    solver.solve(next.tiles, next.rows, next.columns, next.mines, result.probabilities);
+    result.sequence = next.sequence;
+    result.rows = next.rows;
+    result.columns = next.columns;
+    output.publish();
+    published = next.sequence;
+    if (on_publish) { on_publish(); }
+  }
+}
+
+void Heatmap::update(const Bitmap &bitmap, int mines_)
+{
+  auto rows = bitmap.get_rows();
+  auto columns = bitmap.get_columns();
+  auto changed = mines_ != mines || static_cast<std::size_t>(rows * columns) != tiles.size();
+  tiles.resize(static_cast<std::size_t>(rows * columns));
+  for (int row = 0; row < rows; row++) {
+    for (int col = 0; col < columns; col++) {
+      auto tile = read_tile(bitmap.get(row, col));
+      auto &previous = tiles[static_cast<std::size_t>(row * columns + col)];
+      if (previous != tile) {
+        previous = tile;
+        changed = true;
+      }
+    }
+  }
+  if (!changed) { return; }
+  mines = mines_;
+
+  auto &next = input.write_buffer();
+  next.sequence = submitted + 1;
+  next.rows = rows;
+  next.columns = columns;
+  next.mines = mines;
+  next.tiles = tiles;// reuses the capacity of the buffer
+  input.publish();
+  submitted = next.sequence;
+  submitted.notify_one();
+}
+
+void Heatmap::overlay(Bitmap &bitmap)
+{
+  output.refresh();
+  const auto &result = output.read_buffer();
+  if (result.sequence != submitted || result.rows != bitmap.get_rows() || result.columns != bitmap.get_columns()) {
+    return;// the result is for an earlier board, whose probabilities may be wrong for this one
+  }
+  for (int row = 0; row < result.rows; row++) {
+    for (int col = 0; col < result.columns; col++) {
+      auto pixel = bitmap.get(row, col);
+      auto probability = result.probabilities[static_cast<std::size_t>(row * result.columns + col)];
+      if (read_tile(pixel).state == TileState::covered && pixel.background != Color::dark_gray
+          && probability != UNKNOWN_PROBABILITY) {
+        pixel.background = heat_color(probability);
+        bitmap.set(row, col, pixel);
+      }
+    }
+  }
+}
+
+std::uint32_t Heatmap::get_submitted() const { return submitted; }
+
+std::uint32_t Heatmap::get_published() const { return published; }
+
+Color heat_color(float probability)
+{
+  constexpr float CERTAIN = 0.001F;// rounding error away from 0 or 1
+  if (probability < CERTAIN) { return Color::green; }
+  if (probability > 1 - CERTAIN) { return Color::black; }// red is kept for detonated mines
+  if (probability < 0.25F) { return Color::sea_green; }// NOLINT magic numbers
+  if (probability < 0.5F) { return Color::blue; }// NOLINT magic numbers
+  if (probability < 0.75F) { return Color::dark_blue; }// NOLINT magic numbers
+  return Color::dark_red;
+}
+}// namespace minesweeper
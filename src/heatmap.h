@@ -0,0 +1,127 @@
+#ifndef MINESWEEPER_HEATMAP
+#define MINESWEEPER_HEATMAP
+
+#include "board.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace minesweeper {
+
+// Probability reported for tiles that are not covered, or when the visible board is inconsistent.
+constexpr float UNKNOWN_PROBABILITY = -1.0F;
+
+// ProbabilitySolver computes the mine probability of every covered tile from the tiles a player sees, treating flags
+// as mines. Covered tiles next to numbers form frontier components that are solved independently: each is enumerated
+// exactly, or estimated from its neighboring numbers when it has too many arrangements, and the components are then
+// weighed against each other and the remaining tiles by the total mine count. Component solutions are cached by
+// their constraints, so a solve after a click only enumerates the components the click changed.
+class ProbabilitySolver
+{
+  // Solution holds, for each number of mines k in a component, the count of arrangements with k mines and how many
+  // of them place a mine on each component cell. Estimated components carry per-cell probabilities instead.
+  struct Solution
+  {
+    std::vector<int> cells;
+    std::vector<double> weights;
+    std::vector<double> cell_weights;// weights.size() rows of cells.size() columns
+    std::vector<float> estimates;
+  };
+
+  std::map<std::vector<int>, Solution> cache;
+  std::map<std::vector<int>, Solution> next_cache;
+  int enumerated = 0;
+
+public:
+  void solve(std::span<const Tile> tiles, int rows, int columns, int mines, std::vector<float> &probabilities);
+  // Returns the number of components enumerated or estimated by the last solve, rather than found in the cache.
+  [[nodiscard]] int get_enumerated() const;
+};
+
+// TripleBuffer passes values from one writer thread to one reader thread without locks. The writer fills the back
+// buffer and publishes it; the reader picks up the most recently published buffer, skipping any it missed.
+template<typename T> class TripleBuffer
+{
+  static constexpr unsigned int FRESH = 4U;
+
+  std::array<T, 3> buffers{};
+  std::atomic<unsigned int> middle = 1;
+  unsigned int back = 0;
+  unsigned int front = 2;
+
+public:
+  T &write_buffer() { return buffers.at(back); }
+  void publish() { back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & ~FRESH; }
+  // Returns true if a newly published buffer replaced the read buffer.
+  bool refresh()
+  {
+    if ((middle.load(std::memory_order_relaxed) & FRESH) == 0) { return false; }
+    front = middle.exchange(front, std::memory_order_acq_rel) & ~FRESH;
+    return true;
+  }
+  const T &read_buffer() const { return buffers.at(front); }
+};
+
+// Heatmap colors covered tiles of a rendered board by mine probability, from green for safe tiles to black for certain
+// mines. Probabilities are solved on a background thread; the rendering thread hands over the visible tiles when
+// they change and overlays the result once it is published, so it never waits for a solve. The worker calls
+// on_publish after each result, so that the UI can render again instead of waiting for its next event.
+class Heatmap
+{
+  struct Input
+  {
+    std::uint32_t sequence = 0;
+    int rows = 0;
+    int columns = 0;
+    int mines = 0;
+    std::vector<Tile> tiles;
+  };
+
+  struct Output
+  {
+    std::uint32_t sequence = 0;
+    int rows = 0;
+    int columns = 0;
+    std::vector<float> probabilities;
+  };
+
+  TripleBuffer<Input> input;
+  TripleBuffer<Output> output;
+  std::atomic<std::uint32_t> submitted = 0;
+  std::atomic<std::uint32_t> published = 0;
+  std::atomic<bool> stopping = false;
+
+  std::vector<Tile> tiles;// owned by the rendering thread
+  int mines = -1;
+
+  std::function<void()> on_publish;
+  std::thread worker;
+
+  void run();
+
+public:
+  explicit Heatmap(std::function<void()> on_publish_ = {});
+  Heatmap(const Heatmap &) = delete;
+  Heatmap(Heatmap &&) = delete;
+  Heatmap &operator=(const Heatmap &) = delete;
+  Heatmap &operator=(Heatmap &&) = delete;
+  ~Heatmap();
+  // Submits the tiles of a rendered board for solving, unless they are unchanged since the last submission.
+  void update(const Bitmap &bitmap, int mines_);
+  // Colors the covered tiles of a rendered board, leaving the hovered tile as it is. Nothing is colored until the
+  // tiles last submitted have been solved.
+  void overlay(Bitmap &bitmap);
+  [[nodiscard]] std::uint32_t get_submitted() const;
+  [[nodiscard]] std::uint32_t get_published() const;
+};
+
+// Maps a mine probability onto the board palette.
+[[nodiscard]] Color heat_color(float probability);
+}// namespace minesweeper
+
+#endif
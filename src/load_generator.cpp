@@ -0,0 +1,138 @@
+#include "remote_game.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// Results are merged from all worker threads.
+struct Results
+{
+  std::vector<std::chrono::microseconds> latencies;
+  int dropped = 0;
+  std::mutex mutex;
+};
+
+// Each worker thread plays a slice of the clients in lockstep: every client sends one move, then the worker waits
+// for each client's ack. The interval from send to ack is the latency a player perceives for a move. A client that
+// fails to connect or is disconnected counts as dropped and makes no further moves.
+void play_clients(const std::string &address, int clients, int moves, unsigned int seed, Results &results)
+{
+  int dropped = 0;
+  std::vector<std::unique_ptr<minesweeper::RemoteGame>> games;
+  for (int i = 0; i < clients; i++) {
+    auto game = minesweeper::RemoteGame::connect(address);
+    if (game) {
+      while (game->is_connected() && !game->has_board()) { game->poll(-1); }
+    }
+    if (!game || !game->is_connected()) {
+      dropped++;
+      continue;
+    }
+    games.push_back(std::move(game));
+  }
+  if (games.empty()) {
+    std::lock_guard lock{ results.mutex };
+    results.dropped += dropped;
+    return;
+  }
+
+  std::mt19937 mt{ seed };
+  auto board = games.front()->render_board();
+  std::uniform_int_distribution rows{ 0, board.get_rows() - 1 };
+  std::uniform_int_distribution columns{ 0, board.get_columns() - 1 };
+  std::uniform_int_distribution percent{ 0, 99 };// NOLINT magic numbers
+
+  std::vector<std::chrono::microseconds> measured;
+  std::vector<std::uint32_t> seqs(games.size());
+  std::vector<Clock::time_point> sent(games.size());
+  for (int move = 0; move < moves; move++) {
+    for (std::size_t i = 0; i < games.size(); i++) {
+      auto action = percent(mt) < 90 ? minesweeper::Action::right_click : minesweeper::Action::left_click;// NOLINT
+      auto row = rows(mt);
+      auto col = columns(mt);
+      if (!games[i]->is_connected()) { continue; }
+      sent[i] = Clock::now();
+      seqs[i] = games[i]->send(action, row, col);
+    }
+    for (std::size_t i = 0; i < games.size(); i++) {
+      if (!games[i]->is_connected()) { continue; }
+      while (games[i]->is_connected() && games[i]->get_acked() < seqs[i]) { games[i]->poll(-1); }
+      if (games[i]->get_acked() < seqs[i]) { continue; }// disconnected before the move was acknowledged
+      measured.push_back(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - sent[i]));
+    }
+  }
+
+  dropped += static_cast<int>(
+    std::count_if(games.cbegin(), games.cend(), [](const auto &g) { return !g->is_connected(); }));
+
+  std::lock_guard lock{ results.mutex };
+  results.latencies.insert(results.latencies.end(), measured.begin(), measured.end());
+  results.dropped += dropped;
+}
+
+long long percentile(const std::vector<std::chrono::microseconds> &sorted, double fraction)
+{
+  auto index = static_cast<std::size_t>(fraction * static_cast<double>(sorted.size() - 1));
+  return sorted[index].count();
+}
+
+bool parse_count(const std::string &text, int &value)
+{
+  auto [ptr, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+  return error == std::errc{} && ptr == text.data() + text.size() && value > 0;
+}
+}// namespace
+
+// Drives a BoardServer with many concurrent clients: minesweeper_load <address> [clients moves threads]
+int main(int argc, const char *argv[])// NOLINT c-style array
+{
+  std::vector<std::string> args{ argv, std::next(argv, argc) };
+  int clients = 200;// NOLINT magic numbers
+  int moves = 100;// NOLINT magic numbers
+  int threads = 8;// NOLINT magic numbers
+  if ((args.size() != 2 && args.size() != 5)
+      || (args.size() == 5
+          && !(parse_count(args[2], clients) && parse_count(args[3], moves) && parse_count(args[4], threads)))) {
+    std::cerr << "usage: " << args[0] << " unix:<path> | tcp:<port> [clients moves threads]" << std::endl;
+    return 1;
+  }
+
+  Results results;
+  std::vector<std::thread> workers;
+  auto start = Clock::now();
+  for (int t = 0; t < threads; t++) {
+    auto share = clients / threads + (t < clients % threads ? 1 : 0);
+    workers.emplace_back(
+      play_clients, std::cref(args[1]), share, moves, static_cast<unsigned int>(t), std::ref(results));
+  }
+  for (auto &worker : workers) { worker.join(); }
+  auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+  auto &latencies = results.latencies;
+  if (latencies.empty()) {
+    std::cerr << "no moves were acknowledged by " << args[1] << std::endl;
+    return 1;
+  }
+  std::sort(latencies.begin(), latencies.end());
+  std::cout << "moves: " << latencies.size() << ", throughput: " << static_cast<double>(latencies.size()) / elapsed
+            << " moves/s" << std::endl;
+  std::cout << "latency us p50: " << percentile(latencies, 0.5) << ", p99: " << percentile(latencies, 0.99)// NOLINT
+            << ", p99.9: " << percentile(latencies, 0.999)// NOLINT magic numbers
+            << ", max: " << latencies.back().count() << std::endl;
+  if (results.dropped > 0) {
+    std::cerr << "dropped clients: " << results.dropped << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -4,6 +4,17 @@
 #include "ftxui/dom/elements.hpp"
 #include "ftxui/screen/color.hpp"
 #include "game.h"
+#include "heatmap.h"
+#include "session.h"
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include "remote_game.h"
+#endif
 
 ftxui::Color map_color(minesweeper::Color color)
 {
@@ -19,29 +30,47 @@ ftxui::Color map_color(minesweeper::Color color)
   return ftxui::Color::White;
 }
 
-ftxui::Canvas bitmap_to_canvas(const minesweeper::Bitmap &bitmap)
+// Draws a bitmap into a canvas that is kept from frame to frame. The canvas is only rebuilt when the board size
+// changes; otherwise every tile overwrites the cell it drew in the previous frame.
+void bitmap_to_canvas(const minesweeper::Bitmap &bitmap, ftxui::Canvas &canvas)
 {
-  auto canvas = ftxui::Canvas(bitmap.get_columns() * 2, bitmap.get_rows() * 4);
+  if (canvas.width() != bitmap.get_columns() * 2 || canvas.height() != bitmap.get_rows() * 4) {
+    canvas = ftxui::Canvas(bitmap.get_columns() * 2, bitmap.get_rows() * 4);
+  }
   for (int r = 0; r < bitmap.get_rows(); r++) {
     for (int c = 0; c < bitmap.get_columns(); c++) {
       auto pixel = bitmap.get(r, c);
-      canvas.DrawText(c * 2, r * 4, std::string{ 1, pixel.value }, [&pixel](ftxui::Pixel &p) {
+      canvas.DrawText(c * 2, r * 4, std::string(1, pixel.value), [&pixel](ftxui::Pixel &p) {
         p.foreground_color = map_color(pixel.foreground);
         p.background_color = map_color(pixel.background);
         p.bold = true;
       });
     }
   }
-  return canvas;
 }
 
-int main()
+// Runs the terminal UI for a game. Game is either a local Game or a RemoteGame played through a BoardServer.
+template<typename GameType> void play(GameType &game, const std::function<void()> &on_refresh)
 {
-  minesweeper::Game game{ 18, 30, 30, 20, 10, 1 };// NOLINT constant seed parameters for game
-
   using namespace ftxui;
 
-  auto board_renderer = Renderer([&] { return canvas(bitmap_to_canvas(game.render_board())); });
+  auto screen = ScreenInteractive::FitComponent();
+
+  // The board is rendered into buffers that live as long as the UI, and the canvas element refers to its canvas
+  // rather than copying it.
+  minesweeper::Bitmap board_bitmap{ 0, 0 };
+  ftxui::Canvas board_canvas;
+  minesweeper::Heatmap heatmap{ [&screen] { screen.PostEvent(Event::Custom); } };// redraw once the tiles are solved
+  bool show_heatmap = false;
+  auto board_renderer = Renderer([&] {
+    game.render_board(board_bitmap);
+    if (show_heatmap) {
+      heatmap.update(board_bitmap, game.get_mines());
+      heatmap.overlay(board_bitmap);
+    }
+    bitmap_to_canvas(board_bitmap, board_canvas);
+    return canvas(&board_canvas);
+  });
   auto board_with_mouse = CatchEvent(board_renderer, [&](Event e) {
     if (e.is_mouse()) {
       auto &mouse = e.mouse();
@@ -55,11 +84,14 @@ int main()
 
   auto new_game_button = Button("New Game", [&] { game.on_new_game(); });
   auto reset_button = Button("Reset", [&] { game.on_reset_game(); });
+  auto heatmap_button = Button("Heatmap", [&] { show_heatmap = !show_heatmap; });
+  auto quit_button = Button("Quit", screen.ExitLoopClosure());
 
-  auto buttons = Container::Vertical({ new_game_button, reset_button });
+  auto buttons = Container::Vertical({ new_game_button, reset_button, heatmap_button, quit_button });
   auto components = CatchEvent(Container::Horizontal({ board_with_mouse, buttons }), [&](const Event &e) {
     if (e.is_character()) { game.on_key_up(); }
     game.on_refresh_event();
+    on_refresh();
     return false;
   });
 
@@ -75,7 +107,6 @@ int main()
            | border;
   });
 
-  auto screen = ScreenInteractive::FitComponent();
   std::atomic<bool> refresh_ui_continue = true;
   std::thread refresh_ui([&] {
     while (refresh_ui_continue) {
@@ -87,6 +118,34 @@ int main()
   screen.Loop(game_renderer);
   refresh_ui_continue = false;
   refresh_ui.join();
+}
+
+int main(int argc, const char *argv[])// NOLINT c-style array
+{
+  std::vector<std::string> args{ argv, std::next(argv, argc) };
+
+#if defined(__linux__)// join a shared game: minesweeper --connect unix:<path> | tcp:<port>
+  if (args.size() == 3 && args[1] == "--connect") {
+    auto remote = minesweeper::RemoteGame::connect(args[2]);
+    if (!remote) {
+      std::cerr << "unable to connect to " << args[2] << std::endl;
+      return 1;
+    }
+    play(*remote, [] {});
+    return 0;
+  }
+#endif
+
+#if defined(__EMSCRIPTEN__)
+  minesweeper::Game game{ 18, 30, 30, 20, 10, 1 };// NOLINT constant seed parameters for game
+  play(game, [] {});
+#else// resume the previous session, if any, and checkpoint it periodically
+  const std::string session_path = "minesweeper.session";
+  auto game = minesweeper::load_session(session_path).value_or(minesweeper::Game{ 18, 30, 30, 20, 10, 1 });// NOLINT
+  minesweeper::SessionCheckpointer checkpointer{ session_path, std::chrono::seconds{ 5 } };// NOLINT magic numbers
+  play(game, [&] { checkpointer.on_refresh(game); });
+  checkpointer.submit(minesweeper::encode_session(game));// written before the checkpointer is destroyed
+#endif
 
   return 0;
 }
\ No newline at end of file
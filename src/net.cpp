@@ -0,0 +1,130 @@
+#include "net.h"
+#include <arpa/inet.h>
+#include <charconv>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace minesweeper {
+namespace {
+  constexpr int BACKLOG = 1024;
+  const std::string UNIX_PREFIX = "unix:";
+  const std::string TCP_PREFIX = "tcp:";
+
+  bool unix_address(const std::string &address, sockaddr_un &addr)
+  {
+    auto path = address.substr(UNIX_PREFIX.size());
+    if (path.empty() || path.size() >= sizeof(addr.sun_path)) { return false; }
+    addr = {};
+    addr.sun_family = AF_UNIX;
+    std::memcpy(&addr.sun_path[0], path.c_str(), path.size() + 1);
+    return true;
+  }
+
+  bool tcp_address(const std::string &address, sockaddr_in &addr)
+  {
+    auto port_text = address.substr(TCP_PREFIX.size());
+    unsigned short port = 0;
+    auto [end, error] = std::from_chars(port_text.data(), port_text.data() + port_text.size(), port);
+    if (error != std::errc{} || end != port_text.data() + port_text.size()) { return false; }
+    addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return true;
+  }
+
+  int bind_and_listen(int fd, const sockaddr *addr, socklen_t length)
+  {
+    if (::bind(fd, addr, length) != 0 || ::listen(fd, BACKLOG) != 0 || !set_nonblocking(fd)) {
+      ::close(fd);
+      return -1;
+    }
+    return fd;
+  }
+
+  int connect_or_close(int fd, const sockaddr *addr, socklen_t length)
+  {
+    if (::connect(fd, addr, length) != 0) {
+      ::close(fd);
+      return -1;
+    }
+    return fd;
+  }
+}// namespace
+
+int listen_on(const std::string &address)
+{
+  if (address.starts_with(UNIX_PREFIX)) {
+    sockaddr_un addr{};
+    if (!unix_address(address, addr)) { return -1; }
+    ::unlink(&addr.sun_path[0]);// a stale socket file from an earlier server would make bind fail
+    auto fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) { return -1; }
+    return bind_and_listen(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr));// NOLINT sockets API
+  }
+  if (address.starts_with(TCP_PREFIX)) {
+    sockaddr_in addr{};
+    if (!tcp_address(address, addr)) { return -1; }
+    auto fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) { return -1; }
+    int on = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    return bind_and_listen(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr));// NOLINT sockets API
+  }
+  return -1;
+}
+
+int connect_to(const std::string &address)
+{
+  if (address.starts_with(UNIX_PREFIX)) {
+    sockaddr_un addr{};
+    if (!unix_address(address, addr)) { return -1; }
+    auto fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) { return -1; }
+    return connect_or_close(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr));// NOLINT sockets API
+  }
+  if (address.starts_with(TCP_PREFIX)) {
+    sockaddr_in addr{};
+    if (!tcp_address(address, addr)) { return -1; }
+    auto fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) { return -1; }
+    set_nodelay(fd);
+    return connect_or_close(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr));// NOLINT sockets API
+  }
+  return -1;
+}
+
+std::string local_address(int fd)
+{
+  sockaddr_storage storage{};
+  socklen_t length = sizeof(storage);
+  auto *addr = reinterpret_cast<sockaddr *>(&storage);// NOLINT sockets API
+  if (::getsockname(fd, addr, &length) != 0) { return {}; }
+  if (storage.ss_family == AF_INET) {
+    const auto *inet = reinterpret_cast<const sockaddr_in *>(&storage);// NOLINT sockets API
+    return TCP_PREFIX + std::to_string(ntohs(inet->sin_port));
+  }
+  if (storage.ss_family == AF_UNIX) {
+    const auto *local = reinterpret_cast<const sockaddr_un *>(&storage);// NOLINT sockets API
+    return UNIX_PREFIX + std::string{ &local->sun_path[0] };
+  }
+  return {};
+}
+
+void set_nodelay(int fd)
+{
+  int on = 1;
+  ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));// fails harmlessly on unix sockets
+}
+
+bool set_nonblocking(int fd)
+{
+  auto flags = ::fcntl(fd, F_GETFL, 0);// NOLINT vararg
+  return flags >= 0 && ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;// NOLINT vararg
+}
+}// namespace minesweeper
@@ -0,0 +1,22 @@
+#ifndef MINESWEEPER_NET
+#define MINESWEEPER_NET
+
+#include <string>
+
+namespace minesweeper {
+
+// Addresses take the form unix:<path> or tcp:<port>. TCP endpoints are bound to and reached on the loopback
+// interface. Functions return a file descriptor, or -1 on failure.
+[[nodiscard]] int listen_on(const std::string &address);
+[[nodiscard]] int connect_to(const std::string &address);
+
+// Resolves the address a listening socket is bound to, such as the port chosen for tcp:0.
+[[nodiscard]] std::string local_address(int fd);
+
+bool set_nonblocking(int fd);
+
+// Moves and acks are tiny; TCP must never hold them back for coalescing.
+void set_nodelay(int fd);
+}// namespace minesweeper
+
+#endif
@@ -0,0 +1,229 @@
+#include "protocol.h"
+
+namespace minesweeper {
+namespace {
+  constexpr std::size_t LENGTH_SIZE = 4;
+  constexpr std::size_t MOVE_SIZE = 10;
+  constexpr std::size_t STATUS_SIZE = 12;
+  constexpr std::size_t PIXEL_SIZE = 3;
+  constexpr std::size_t BOARD_HEADER_SIZE = 1 + STATUS_SIZE + 4;
+  constexpr int MAX_DIMENSION = 0xFFFF;
+  constexpr std::size_t UPDATE_SIZE = 4 + PIXEL_SIZE;
+  constexpr unsigned int BYTE_BITS = 8;
+  constexpr unsigned int BYTE_MASK = 0xFFU;
+
+  void put_u16(std::vector<std::uint8_t> &out, unsigned int value)
+  {
+    out.push_back(static_cast<std::uint8_t>(value & BYTE_MASK));
+    out.push_back(static_cast<std::uint8_t>((value >> BYTE_BITS) & BYTE_MASK));
+  }
+
+  void put_u32(std::vector<std::uint8_t> &out, std::uint32_t value)
+  {
+    for (unsigned int shift = 0; shift < 4 * BYTE_BITS; shift += BYTE_BITS) {
+      out.push_back(static_cast<std::uint8_t>((value >> shift) & BYTE_MASK));
+    }
+  }
+
+  std::uint32_t get_u32(std::span<const std::uint8_t> in, std::size_t offset)
+  {
+    std::uint32_t value = 0;
+    for (unsigned int i = 0; i < 4; i++) { value |= static_cast<std::uint32_t>(in[offset + i]) << (i * BYTE_BITS); }
+    return value;
+  }
+
+  unsigned int get_u16(std::span<const std::uint8_t> in, std::size_t offset)
+  {
+    return static_cast<unsigned int>(in[offset]) | (static_cast<unsigned int>(in[offset + 1]) << BYTE_BITS);
+  }
+
+  void put_pixel(std::vector<std::uint8_t> &out, const Pixel &pixel)
+  {
+    out.push_back(static_cast<std::uint8_t>(pixel.foreground));
+    out.push_back(static_cast<std::uint8_t>(pixel.background));
+    out.push_back(static_cast<std::uint8_t>(pixel.value));
+  }
+
+  Pixel read_pixel(std::span<const std::uint8_t> in, std::size_t offset)
+  {
+    return { static_cast<Color>(in[offset]), static_cast<Color>(in[offset + 1]), static_cast<char>(in[offset + 2]) };
+  }
+
+  void put_status(std::vector<std::uint8_t> &out, const Status &status)
+  {
+    put_u32(out, static_cast<std::uint32_t>(status.round));
+    put_u32(out, static_cast<std::uint32_t>(status.time));
+    put_u32(out, static_cast<std::uint32_t>(status.mines));
+  }
+
+  // Reserves the length prefix of a frame and returns its offset so that it can be patched once the payload is known.
+  std::size_t begin_frame(std::vector<std::uint8_t> &out, MessageType type)
+  {
+    auto offset = out.size();
+    put_u32(out, 0);
+    out.push_back(static_cast<std::uint8_t>(type));
+    return offset;
+  }
+
+  void end_frame(std::vector<std::uint8_t> &out, std::size_t offset)
+  {
+    auto length = static_cast<std::uint32_t>(out.size() - offset - LENGTH_SIZE);
+    for (unsigned int i = 0; i < 4; i++) {
+      out[offset + i] = static_cast<std::uint8_t>((length >> (i * BYTE_BITS)) & BYTE_MASK);
+    }
+  }
+}// namespace
+
+void encode_move(std::vector<std::uint8_t> &out, const Move &move)
+{
+  auto offset = begin_frame(out, MessageType::move);
+  put_u32(out, move.seq);
+  out.push_back(static_cast<std::uint8_t>(move.action));
+  put_u16(out, static_cast<unsigned int>(move.row));
+  put_u16(out, static_cast<unsigned int>(move.col));
+  end_frame(out, offset);
+}
+
+void encode_board(std::vector<std::uint8_t> &out, const Status &status, const Bitmap &bitmap)
+{
+  auto offset = begin_frame(out, MessageType::board);
+  put_status(out, status);
+  put_u16(out, static_cast<unsigned int>(bitmap.get_rows()));
+  put_u16(out, static_cast<unsigned int>(bitmap.get_columns()));
+  for (int r = 0; r < bitmap.get_rows(); r++) {
+    for (int c = 0; c < bitmap.get_columns(); c++) { put_pixel(out, bitmap.get(r, c)); }
+  }
+  end_frame(out, offset);
+}
+
+void encode_diff(std::vector<std::uint8_t> &out, const Status &status, std::span<const CellUpdate> updates)
+{
+  auto offset = begin_frame(out, MessageType::diff);
+  put_status(out, status);
+  put_u32(out, static_cast<std::uint32_t>(updates.size()));
+  for (const auto &update : updates) {
+    put_u16(out, static_cast<unsigned int>(update.row));
+    put_u16(out, static_cast<unsigned int>(update.col));
+    put_pixel(out, update.pixel);
+  }
+  end_frame(out, offset);
+}
+
+void encode_ack(std::vector<std::uint8_t> &out, std::uint32_t seq)
+{
+  auto offset = begin_frame(out, MessageType::ack);
+  put_u32(out, seq);
+  end_frame(out, offset);
+}
+
+std::optional<Move> decode_move(std::span<const std::uint8_t> payload)
+{
+  if (payload.size() != MOVE_SIZE || payload[0] != static_cast<std::uint8_t>(MessageType::move)) {
+    return std::nullopt;
+  }
+  if (payload[5] > static_cast<std::uint8_t>(Action::reset_game)) { return std::nullopt; }
+  return Move{ get_u32(payload, 1),
+    static_cast<Action>(payload[5]),
+    static_cast<int>(get_u16(payload, 6)),
+    static_cast<int>(get_u16(payload, 8)) };
+}
+
+std::optional<std::uint32_t> decode_ack(std::span<const std::uint8_t> payload)
+{
+  if (payload.size() != 1 + 4 || payload[0] != static_cast<std::uint8_t>(MessageType::ack)) { return std::nullopt; }
+  return get_u32(payload, 1);
+}
+
+std::optional<Status> decode_status(std::span<const std::uint8_t> payload)
+{
+  if (payload.size() < 1 + STATUS_SIZE) { return std::nullopt; }
+  return Status{ static_cast<int>(get_u32(payload, 1)),
+    static_cast<int>(get_u32(payload, 5)),
+    static_cast<int>(get_u32(payload, 9)) };
+}
+
+std::optional<Bitmap> decode_board(std::span<const std::uint8_t> payload)
+{
+  if (payload.size() < BOARD_HEADER_SIZE || payload[0] != static_cast<std::uint8_t>(MessageType::board)) {
+    return std::nullopt;
+  }
+  auto rows = static_cast<int>(get_u16(payload, 1 + STATUS_SIZE));
+  auto columns = static_cast<int>(get_u16(payload, 1 + STATUS_SIZE + 2));
+  auto cells = static_cast<std::size_t>(rows) * static_cast<std::size_t>(columns);
+  if (payload.size() != BOARD_HEADER_SIZE + cells * PIXEL_SIZE) { return std::nullopt; }
+  Bitmap bitmap{ rows, columns };
+  auto offset = BOARD_HEADER_SIZE;
+  for (int r = 0; r < rows; r++) {
+    for (int c = 0; c < columns; c++) {
+      bitmap.set(r, c, read_pixel(payload, offset));
+      offset += PIXEL_SIZE;
+    }
+  }
+  return bitmap;
+}
+
+bool apply_diff(std::span<const std::uint8_t> payload, Bitmap &bitmap)
+{
+  constexpr std::size_t header = 1 + STATUS_SIZE + 4;
+  if (payload.size() < header || payload[0] != static_cast<std::uint8_t>(MessageType::diff)) { return false; }
+  auto count = static_cast<std::size_t>(get_u32(payload, 1 + STATUS_SIZE));
+  if (payload.size() != header + count * UPDATE_SIZE) { return false; }
+  auto offset = header;
+  for (std::size_t i = 0; i < count; i++) {
+    auto row = static_cast<int>(get_u16(payload, offset));
+    auto col = static_cast<int>(get_u16(payload, offset + 2));
+    if (row >= bitmap.get_rows() || col >= bitmap.get_columns()) { return false; }
+    bitmap.set(row, col, read_pixel(payload, offset + 4));
+    offset += UPDATE_SIZE;
+  }
+  return true;
+}
+
+bool fits_protocol(int rows, int columns)
+{
+  if (rows < 1 || columns < 1 || rows > MAX_DIMENSION || columns > MAX_DIMENSION) { return false; }
+  auto cells = static_cast<std::size_t>(rows) * static_cast<std::size_t>(columns);
+  return BOARD_HEADER_SIZE + cells * PIXEL_SIZE <= FrameReader::MAX_PAYLOAD;
+}
+
+void diff_bitmaps(const Bitmap &before, const Bitmap &after, std::vector<CellUpdate> &updates)
+{
+  for (int r = 0; r < after.get_rows(); r++) {
+    for (int c = 0; c < after.get_columns(); c++) {
+      auto a = before.get(r, c);
+      auto b = after.get(r, c);
+      if (a.foreground != b.foreground || a.background != b.background || a.value != b.value) {
+        updates.push_back({ r, c, b });
+      }
+    }
+  }
+}
+
+void FrameReader::append(std::span<const std::uint8_t> bytes)
+{
+  if (start > 0) {// compact consumed frames before growing the buffer
+    buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(start));
+    start = 0;
+  }
+  buffer.insert(buffer.end(), bytes.begin(), bytes.end());
+}
+
+std::optional<std::span<const std::uint8_t>> FrameReader::next()
+{
+  auto available = buffer.size() - start;
+  if (corrupt || available < LENGTH_SIZE) { return std::nullopt; }
+  auto length = get_u32(buffer, start);
+  if (length == 0 || length > MAX_PAYLOAD) {
+    corrupt = true;
+    return std::nullopt;
+  }
+  if (available < LENGTH_SIZE + length) { return std::nullopt; }
+  auto payload = std::span{ buffer }.subspan(start + LENGTH_SIZE, length);
+  start += LENGTH_SIZE + length;
+  return payload;
+}
+
+bool FrameReader::is_corrupt() const { return corrupt; }
+
+std::size_t FrameReader::get_buffered() const { return buffer.size() - start; }
+}// namespace minesweeper
@@ -0,0 +1,81 @@
+#ifndef MINESWEEPER_PROTOCOL
+#define MINESWEEPER_PROTOCOL
+
+#include "bitmap.h"
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace minesweeper {
+
+// Every message is a frame: a 32-bit little-endian payload length followed by the payload.
+// The first payload byte identifies the message type.
+enum class MessageType : std::uint8_t { move = 'M', board = 'B', diff = 'D', ack = 'A' };
+
+// Action is what a client asks the server to do with the shared game.
+enum class Action : std::uint8_t { left_click, right_click, new_game, reset_game };
+
+// Move is the only client-to-server message. The server acknowledges each move by sequence number.
+struct Move
+{
+  std::uint32_t seq;
+  Action action;
+  int row;
+  int col;
+};
+
+// Status carries the game values displayed beside the board.
+struct Status
+{
+  int round;
+  int time;
+  int mines;
+};
+
+// CellUpdate is a single changed tile in a diff message.
+struct CellUpdate
+{
+  int row;
+  int col;
+  Pixel pixel;
+};
+
+void encode_move(std::vector<std::uint8_t> &out, const Move &move);
+void encode_board(std::vector<std::uint8_t> &out, const Status &status, const Bitmap &bitmap);
+void encode_diff(std::vector<std::uint8_t> &out, const Status &status, std::span<const CellUpdate> updates);
+void encode_ack(std::vector<std::uint8_t> &out, std::uint32_t seq);
+
+[[nodiscard]] std::optional<Move> decode_move(std::span<const std::uint8_t> payload);
+[[nodiscard]] std::optional<std::uint32_t> decode_ack(std::span<const std::uint8_t> payload);
+[[nodiscard]] std::optional<Status> decode_status(std::span<const std::uint8_t> payload);// board or diff message
+[[nodiscard]] std::optional<Bitmap> decode_board(std::span<const std::uint8_t> payload);
+bool apply_diff(std::span<const std::uint8_t> payload, Bitmap &bitmap);
+
+// Rows and columns travel as 16-bit fields, and a whole board is sent in one frame. Returns true if a board of this
+// size can be served.
+[[nodiscard]] bool fits_protocol(int rows, int columns);
+
+// Appends the tiles that differ between two equally sized bitmaps.
+void diff_bitmaps(const Bitmap &before, const Bitmap &after, std::vector<CellUpdate> &updates);
+
+// FrameReader accumulates stream bytes and yields complete frame payloads.
+class FrameReader
+{
+  std::vector<std::uint8_t> buffer;
+  std::size_t start = 0;
+  bool corrupt = false;
+
+public:
+  static constexpr std::uint32_t MAX_PAYLOAD = 1U << 24U;
+
+  void append(std::span<const std::uint8_t> bytes);
+  // The returned payload is valid until the next call to append.
+  [[nodiscard]] std::optional<std::span<const std::uint8_t>> next();
+  [[nodiscard]] bool is_corrupt() const;
+  // Returns the number of bytes appended but not yet returned in a frame.
+  [[nodiscard]] std::size_t get_buffered() const;
+};
+}// namespace minesweeper
+
+#endif
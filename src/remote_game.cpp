@@ -0,0 +1,141 @@
+#include "remote_game.h"
+#include "net.h"
+#include <array>
+#include <cerrno>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <utility>
+
+namespace minesweeper {
+namespace {
+  constexpr std::size_t READ_SIZE = 1U << 16U;
+}// namespace
+
+RemoteGame::RemoteGame(int fd_) : fd(fd_) {}
+
+std::unique_ptr<RemoteGame> RemoteGame::connect(const std::string &address)
+{
+  auto fd = connect_to(address);
+  if (fd < 0) { return nullptr; }
+  return std::unique_ptr<RemoteGame>(new RemoteGame(fd));// NOLINT private constructor
+}
+
+RemoteGame::~RemoteGame() { ::close(fd); }
+
+std::uint32_t RemoteGame::send(Action action, int row, int col)
+{
+  auto seq = ++next_seq;
+  out.clear();
+  encode_move(out, { seq, action, row, col });
+  std::size_t offset = 0;
+  while (connected && offset < out.size()) {
+    auto sent = ::send(fd, &out[offset], out.size() - offset, MSG_NOSIGNAL);
+    if (sent > 0) {
+      offset += static_cast<std::size_t>(sent);
+    } else if (sent < 0 && errno != EINTR) {
+      connected = false;
+    }
+  }
+  return seq;
+}
+
+bool RemoteGame::poll(int timeout_ms)
+{
+  std::array<std::uint8_t, READ_SIZE> buffer{};
+  pollfd request{ fd, POLLIN, 0 };
+  auto wait = timeout_ms;
+  while (connected && ::poll(&request, 1, wait) > 0) {
+    auto received = ::recv(fd, buffer.data(), buffer.size(), MSG_DONTWAIT);
+    if (received <= 0) {
+      if (received == 0 || (errno != EAGAIN && errno != EINTR)) { connected = false; }
+      break;
+    }
+    reader.append(std::span{ buffer }.first(static_cast<std::size_t>(received)));
+    while (auto payload = reader.next()) {
+      if (!apply(*payload)) { connected = false; }
+    }
+    if (reader.is_corrupt()) { connected = false; }
+    wait = 0;// drain whatever else has arrived without blocking again
+  }
+  return connected;
+}
+
+bool RemoteGame::apply(std::span<const std::uint8_t> payload)
+{
+  if (auto seq = decode_ack(payload)) {
+    acked = *seq;
+    return true;
+  }
+  auto update = decode_status(payload);
+  if (!update) { return false; }
+  if (payload[0] == static_cast<std::uint8_t>(MessageType::board)) {
+    auto bitmap = decode_board(payload);
+    if (!bitmap) { return false; }
+    board.emplace(std::move(*bitmap));
+  } else if (!board || !apply_diff(payload, *board)) {
+    return false;
+  }
+  status = *update;
+  return true;
+}
+
+std::uint32_t RemoteGame::get_acked() const { return acked; }
+
+bool RemoteGame::is_connected() const { return connected; }
+
+bool RemoteGame::has_board() const { return board.has_value(); }
+
+int RemoteGame::get_round() const { return status.round; }
+
+int RemoteGame::get_time() const { return status.time; }
+
+int RemoteGame::get_mines() const { return status.mines; }
+
+void RemoteGame::on_mouse_event(int row, int col, bool left_click, bool right_click, bool mouse_up)
+{
+  hover_row = row;
+  hover_col = col;
+  if (board && mouse_up && row >= 0 && row < board->get_rows() && col >= 0 && col < board->get_columns()) {
+    if (left_click) {
+      send(Action::left_click, row, col);
+    } else if (right_click) {
+      send(Action::right_click, row, col);
+    }
+  }
+}
+
+void RemoteGame::on_key_up()
+{
+  if (board && hover_row >= 0 && hover_row < board->get_rows() && hover_col >= 0 && hover_col < board->get_columns()) {
+    send(Action::right_click, hover_row, hover_col);
+  }
+}
+
+void RemoteGame::on_refresh_event() { poll(0); }
+
+void RemoteGame::on_new_game() { send(Action::new_game, 0, 0); }
+
+void RemoteGame::on_reset_game() { send(Action::reset_game, 0, 0); }
+
+Bitmap RemoteGame::render_board() const
+{
+  Bitmap bitmap{ 0, 0 };
+  render_board(bitmap);
+  return bitmap;
+}
+
+void RemoteGame::render_board(Bitmap &bitmap) const
+{
+  if (!board) {
+    bitmap.resize(0, 0);
+    return;
+  }
+  bitmap = *board;// copy assignment reuses the pixel storage of an equally sized bitmap
+  if (hover_row >= 0 && hover_row < bitmap.get_rows() && hover_col >= 0 && hover_col < bitmap.get_columns()) {
+    auto pixel = bitmap.get(hover_row, hover_col);
+    pixel.background = Color::dark_gray;
+    bitmap.set(hover_row, hover_col, pixel);
+  }
+}
+}// namespace minesweeper
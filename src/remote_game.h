@@ -0,0 +1,63 @@
+#ifndef MINESWEEPER_REMOTE_GAME
+#define MINESWEEPER_REMOTE_GAME
+
+#include "protocol.h"
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace minesweeper {
+
+// RemoteGame plays a game hosted by a BoardServer. It mirrors the event and query interface of Game, so that the
+// terminal UI can drive either one, and keeps a local copy of the shared board that is patched by server diffs.
+class RemoteGame
+{
+  const int fd;
+
+  FrameReader reader;
+  std::vector<std::uint8_t> out;
+  std::optional<Bitmap> board;
+  Status status{ 0, 0, 0 };
+  std::uint32_t next_seq = 0;
+  std::uint32_t acked = 0;
+  bool connected = true;
+
+  int hover_row = -1;
+  int hover_col = -1;
+
+  explicit RemoteGame(int fd_);
+  bool apply(std::span<const std::uint8_t> payload);
+
+public:
+  // Returns nullptr if the server cannot be reached.
+  [[nodiscard]] static std::unique_ptr<RemoteGame> connect(const std::string &address);
+  RemoteGame(const RemoteGame &) = delete;
+  RemoteGame(RemoteGame &&) = delete;
+  RemoteGame &operator=(const RemoteGame &) = delete;
+  RemoteGame &operator=(RemoteGame &&) = delete;
+  ~RemoteGame();
+
+  // Sends a move and returns its sequence number, which the server acknowledges once the move is applied.
+  std::uint32_t send(Action action, int row, int col);
+  // Waits up to timeout_ms for server messages and applies all that have arrived. Returns false once disconnected.
+  bool poll(int timeout_ms);
+  [[nodiscard]] std::uint32_t get_acked() const;
+  [[nodiscard]] bool is_connected() const;
+  [[nodiscard]] bool has_board() const;
+
+  [[nodiscard]] int get_round() const;
+  [[nodiscard]] int get_time() const;
+  [[nodiscard]] int get_mines() const;
+  void on_mouse_event(int row, int col, bool left_click, bool right_click, bool mouse_up);
+  void on_key_up();
+  void on_refresh_event();
+  void on_new_game();
+  void on_reset_game();
+  [[nodiscard]] Bitmap render_board() const;
+  void render_board(Bitmap &bitmap) const;
+};
+}// namespace minesweeper
+
+#endif
@@ -0,0 +1,60 @@
+#include "board_server.h"
+#include <charconv>
+#include <csignal>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+constexpr int MINES_INIT = 10;// NOLINT magic numbers
+
+minesweeper::BoardServer *running = nullptr;// NOLINT global needed by the signal handler
+
+void on_signal(int /*signal*/)
+{
+  if (running != nullptr) { running->stop(); }// stop only writes to an eventfd, which is async-signal-safe
+}
+
+bool parse_int(const std::string &text, int &value)
+{
+  auto [ptr, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+  return error == std::errc{} && ptr == text.data() + text.size();
+}
+
+// The board must fit the protocol and leave at least one safe tile for the initial mines.
+bool parse_size(const std::vector<std::string> &args, int &rows, int &columns)
+{
+  if (args.size() == 2) { return true; }
+  return parse_int(args[2], rows) && parse_int(args[3], columns) && minesweeper::fits_protocol(rows, columns)
+         && static_cast<long long>(rows) * columns > MINES_INIT;
+}
+}// namespace
+
+// Hosts a shared game: minesweeper_server unix:<path> | tcp:<port> [rows columns]
+int main(int argc, const char *argv[])// NOLINT c-style array
+{
+  std::vector<std::string> args{ argv, std::next(argv, argc) };
+  int rows = 18;// NOLINT default board size of the terminal game
+  int columns = 30;// NOLINT default board size of the terminal game
+  if ((args.size() != 2 && args.size() != 4) || !parse_size(args, rows, columns)) {
+    std::cerr << "usage: " << args[0] << " unix:<path> | tcp:<port> [rows columns]" << std::endl;
+    std::cerr << "rows and columns range from 1 to 65535, and the board needs more than " << MINES_INIT
+              << " tiles and must fit in one frame" << std::endl;
+    return 1;
+  }
+
+  auto server =
+    minesweeper::BoardServer::listen(args[1], minesweeper::Game{ rows, columns, 30, 20, MINES_INIT, 1 });// NOLINT
+  if (!server) {
+    std::cerr << "unable to listen on " << args[1] << std::endl;
+    return 1;
+  }
+  running = server.get();
+  std::signal(SIGINT, on_signal);
+  std::signal(SIGTERM, on_signal);
+  std::cout << "serving " << rows << "x" << columns << " board on " << server->address() << std::endl;
+  server->run();
+  running = nullptr;
+  return 0;
+}
@@ -0,0 +1,210 @@
+#include "session.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <utility>
+
+#if defined(_WIN32)
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace minesweeper {
+namespace {
+  std::size_t cell_count(const SessionHeader &header)
+  {
+    return static_cast<std::size_t>(header.rows) * static_cast<std::size_t>(header.columns);
+  }
+
+  // The cell count must fit an int, since the board indexes its cells by row * columns + col. A new game must be able
+  // to place its initial mines, or assigning them never finishes.
+  bool valid(const SessionHeader &header, std::size_t size)
+  {
+    return header.magic == SESSION_MAGIC && header.version == SESSION_VERSION && header.rows > 0
+           && header.columns > 0 && header.rows <= std::numeric_limits<int>::max() / header.columns
+           && header.mines >= 0 && header.mines <= header.rows * header.columns && header.mines_init >= 0
+           && header.mines_init <= header.rows * header.columns && header.mines_increment >= 0 && header.time_init > 0
+           && header.state >= 0 && header.state <= 2 && header.round >= 1
+           && size == sizeof(SessionHeader) + cell_count(header);
+  }
+
+#if defined(_WIN32)
+  bool write_file(const std::string &path, std::span<const std::uint8_t> image)
+  {
+    std::ofstream out{ path, std::ios::binary | std::ios::trunc };
+    out.write(reinterpret_cast<const char *>(image.data()), static_cast<std::streamsize>(image.size()));// NOLINT
+    out.flush();
+    return out.good();
+  }
+
+  bool sync_directory(const std::string & /*path*/) { return true; }// Windows offers no directory fsync
+#else
+  bool write_file(const std::string &path, std::span<const std::uint8_t> image)
+  {
+    auto fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);// NOLINT vararg and octal mode
+    if (fd < 0) { return false; }
+    auto *next = image.data();
+    auto remaining = image.size();
+    while (remaining > 0) {
+      auto written = ::write(fd, next, remaining);
+      if (written <= 0) {
+        ::close(fd);
+        return false;
+      }
+      next += written;// NOLINT pointer arithmetic
+      remaining -= static_cast<std::size_t>(written);
+    }
+    auto synced = ::fsync(fd) == 0;// data must be durable before the rename publishes it
+    return ::close(fd) == 0 && synced;
+  }
+
+  // Syncs the directory holding a file, so that a rename into it survives a crash.
+  bool sync_directory(const std::string &path)
+  {
+    auto directory = std::filesystem::path{ path }.parent_path();
+    if (directory.empty()) { directory = "."; }
+    auto fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);// NOLINT vararg
+    if (fd < 0) { return false; }
+    auto synced = ::fsync(fd) == 0;
+    return ::close(fd) == 0 && synced;
+  }
+#endif
+}// namespace
+
+std::vector<std::uint8_t> encode_session(const Game &game)
+{
+  const auto &board = game.get_board();
+  auto snapshot = game.snapshot();
+  SessionHeader header{ SESSION_MAGIC,
+    SESSION_VERSION,
+    board.get_rows(),
+    board.get_columns(),
+    board.get_mines(),
+    snapshot.time_init,
+    snapshot.time_increment,
+    snapshot.mines_init,
+    snapshot.mines_increment,
+    snapshot.state,
+    snapshot.round,
+    snapshot.time,
+    snapshot.elapsed_ms };
+  std::vector<std::uint8_t> image(sizeof(SessionHeader) + cell_count(header));
+  std::memcpy(image.data(), &header, sizeof(SessionHeader));
+  board.encode(std::span{ image }.subspan(sizeof(SessionHeader)));
+  return image;
+}
+
+std::optional<Game> decode_session(std::span<const std::uint8_t> image)
+{
+  if (image.size() < sizeof(SessionHeader)) { return std::nullopt; }
+  SessionHeader header{};
+  std::memcpy(&header, image.data(), sizeof(SessionHeader));// the mapping offers no alignment guarantee
+  auto cells = image.subspan(sizeof(SessionHeader));
+  if (!valid(header, image.size()) || Board::count_encoded_mines(cells) != header.mines) { return std::nullopt; }
+  GameSnapshot snapshot{ header.time_init,
+    header.time_increment,
+    header.mines_init,
+    header.mines_increment,
+    header.state,
+    header.round,
+    header.time,
+    header.elapsed_ms };
+  return Game{ snapshot, Board{ header.rows, header.columns, header.mines, cells } };
+}
+
+bool write_session(const std::string &path, std::span<const std::uint8_t> image)
+{
+  auto temp = path + ".tmp";
+  if (!write_file(temp, image)) { return false; }
+  std::error_code error;
+  std::filesystem::rename(temp, path, error);
+  return !error && sync_directory(path);
+}
+
+bool save_session(const std::string &path, const Game &game) { return write_session(path, encode_session(game)); }
+
+#if defined(_WIN32)
+std::optional<Game> load_session(const std::string &path)
+{
+  std::ifstream in{ path, std::ios::binary };
+  if (!in) { return std::nullopt; }
+  std::vector<std::uint8_t> image{ std::istreambuf_iterator<char>{ in }, std::istreambuf_iterator<char>{} };
+  return decode_session(image);
+}
+#else
+std::optional<Game> load_session(const std::string &path)
+{
+  auto fd = ::open(path.c_str(), O_RDONLY);// NOLINT vararg
+  if (fd < 0) { return std::nullopt; }
+  struct stat info
+  {
+  };
+  if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+    ::close(fd);
+    return std::nullopt;
+  }
+  auto size = static_cast<std::size_t>(info.st_size);
+  auto *mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);// the mapping outlives the descriptor
+  if (mapped == MAP_FAILED) { return std::nullopt; }// NOLINT C-style cast in macro
+  auto game = decode_session({ static_cast<const std::uint8_t *>(mapped), size });
+  ::munmap(mapped, size);
+  return game;
+}
+#endif
+
+SessionCheckpointer::SessionCheckpointer(std::string path_, std::chrono::milliseconds interval_)
+  : path(std::move(path_)), interval(interval_), last_submit(std::chrono::steady_clock::now()),
+    worker([this] { run(); })
+{}
+
+SessionCheckpointer::~SessionCheckpointer()
+{
+  {
+    std::lock_guard lock{ mutex };
+    stopping = true;
+  }
+  signal.notify_one();
+  worker.join();
+}
+
+void SessionCheckpointer::on_refresh(const Game &game)
+{
+  auto now = std::chrono::steady_clock::now();
+  if (now - last_submit >= interval) {
+    last_submit = now;
+    submit(encode_session(game));
+  }
+}
+
+void SessionCheckpointer::submit(std::vector<std::uint8_t> image)
+{
+  {
+    std::lock_guard lock{ mutex };
+    pending = std::move(image);// a newer checkpoint supersedes one that has not been written yet
+  }
+  signal.notify_one();
+}
+
+void SessionCheckpointer::run()
+{
+  std::unique_lock lock{ mutex };
+  while (true) {
+    signal.wait(lock, [this] { return stopping || pending.has_value(); });
+    if (pending) {
+      auto image = std::move(*pending);
+      pending.reset();
+      lock.unlock();
+      write_session(path, image);
+      lock.lock();
+    } else if (stopping) {
+      return;
+    }
+  }
+}
+}// namespace minesweeper
@@ -0,0 +1,79 @@
+#ifndef MINESWEEPER_SESSION
+#define MINESWEEPER_SESSION
+
+#include "game.h"
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace minesweeper {
+
+// SessionHeader is the fixed-layout prefix of a session file. One encoded byte per board cell follows it.
+// Fields are stored in native byte order; a mismatched magic or version rejects the file.
+struct SessionHeader
+{
+  std::array<char, 4> magic;
+  std::uint32_t version;
+  std::int32_t rows;
+  std::int32_t columns;
+  std::int32_t mines;
+  std::int32_t time_init;
+  std::int32_t time_increment;
+  std::int32_t mines_init;
+  std::int32_t mines_increment;
+  std::int32_t state;
+  std::int32_t round;
+  std::int32_t time;
+  std::int64_t elapsed_ms;
+};
+
+constexpr std::array<char, 4> SESSION_MAGIC{ 'M', 'S', 'W', 'P' };
+constexpr std::uint32_t SESSION_VERSION = 1;
+
+[[nodiscard]] std::vector<std::uint8_t> encode_session(const Game &game);
+[[nodiscard]] std::optional<Game> decode_session(std::span<const std::uint8_t> image);
+
+// Session files are replaced atomically: the image is written to a temporary sibling file and renamed into place.
+// On POSIX systems the file and then its directory are synced, so a saved session survives a crash.
+bool write_session(const std::string &path, std::span<const std::uint8_t> image);
+bool save_session(const std::string &path, const Game &game);
+
+// Loading memory-maps the session file, so resuming a large board does not copy it through a stream.
+[[nodiscard]] std::optional<Game> load_session(const std::string &path);
+
+// SessionCheckpointer periodically writes a game to a session file from a background thread.
+// Encoding happens on the caller's thread, which owns the game; only the finished image crosses threads.
+class SessionCheckpointer
+{
+  const std::string path;
+  const std::chrono::milliseconds interval;
+
+  std::chrono::steady_clock::time_point last_submit{};
+  std::optional<std::vector<std::uint8_t>> pending;
+  bool stopping = false;
+  std::mutex mutex;
+  std::condition_variable signal;
+  std::thread worker;
+
+  void run();
+
+public:
+  SessionCheckpointer(std::string path_, std::chrono::milliseconds interval_);
+  SessionCheckpointer(const SessionCheckpointer &) = delete;
+  SessionCheckpointer(SessionCheckpointer &&) = delete;
+  SessionCheckpointer &operator=(const SessionCheckpointer &) = delete;
+  SessionCheckpointer &operator=(SessionCheckpointer &&) = delete;
+  ~SessionCheckpointer();
+  void on_refresh(const Game &game);
+  void submit(std::vector<std::uint8_t> image);
+};
+}// namespace minesweeper
+
+#endif
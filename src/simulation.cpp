@@ -0,0 +1,58 @@
+#include "simulation.h"
+#include "board.h"
+#include "bot.h"
+#include <algorithm>
+
+namespace minesweeper {
+RoundStats &RoundStats::operator+=(const RoundStats &other)
+{
+  reached += other.reached;
+  solved += other.solved;
+  deaths += other.deaths;
+  solve_seconds += other.solve_seconds;
+  return *this;
+}
+
+void simulate_game(const SimulationParameters &parameters, unsigned int seed, std::vector<RoundStats> &stats)
+{
+  Board board{ parameters.rows, parameters.columns, parameters.mines_init, seed };
+  Bot bot{ seed };
+  Bitmap bitmap{ 0, 0 };
+  std::vector<Click> clicks;
+  double elapsed = 0;
+  double time = parameters.time_init;
+  for (int round = 1; round <= parameters.max_rounds && elapsed < time; round++) {
+    if (stats.size() < static_cast<std::size_t>(round)) { stats.resize(static_cast<std::size_t>(round)); }
+    auto &round_stats = stats[static_cast<std::size_t>(round - 1)];
+    round_stats.reached++;
+    auto round_start = elapsed;
+    auto complete = board.is_complete();
+    while (elapsed < time && !complete) {
+      board.render(bitmap);
+      const auto &moves = bot.next(bitmap);
+      if (moves.empty()) { break; }
+      clicks.clear();// the moves that can be made before time runs out
+      for (auto start = elapsed; clicks.size() < moves.size() && start < time; start += parameters.seconds_per_move) {
+        const auto &move = moves[clicks.size()];
+        clicks.push_back({ move.row, move.col, move.flag });
+      }
+      auto result = board.on_clicks(clicks);
+      for (std::size_t i = 0; i < result.applied; i++) { elapsed += parameters.seconds_per_move; }
+      complete = result.complete;
+      if (!result.alive) {// reset the board, as a player would, and keep the mine in mind
+        const auto &click = clicks[result.applied - 1];
+        round_stats.deaths++;
+        bot.on_detonation(click.row, click.col);
+        board.restore();
+        complete = false;
+      }
+    }
+    if (elapsed >= time || !complete) { return; }
+    round_stats.solved++;
+    round_stats.solve_seconds += elapsed - round_start;
+    time += parameters.time_increment;
+    board.update(std::min(parameters.rows * parameters.columns, board.get_mines() + parameters.mines_increment));
+    bot.on_new_board();
+  }
+}
+}// namespace minesweeper
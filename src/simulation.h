@@ -0,0 +1,38 @@
+#ifndef MINESWEEPER_SIMULATION
+#define MINESWEEPER_SIMULATION
+
+#include <vector>
+
+namespace minesweeper {
+
+// SimulationParameters are the Game constructor arguments plus the pace of the simulated player.
+struct SimulationParameters
+{
+  int rows;
+  int columns;
+  int time_init;
+  int time_increment;
+  int mines_init;
+  int mines_increment;
+  double seconds_per_move;
+  int max_rounds;
+};
+
+// RoundStats accumulates the outcomes of one round over many simulated games.
+struct RoundStats
+{
+  long long reached = 0;
+  long long solved = 0;
+  long long deaths = 0;
+  double solve_seconds = 0;
+
+  RoundStats &operator+=(const RoundStats &other);
+};
+
+// Simulates one marathon played by a Bot under the rules of Game: the clock runs across rounds, each solved board
+// adds time_increment seconds and mines_increment mines, and a detonation resets the board at the cost of the moves
+// already spent on it. Outcomes are added to stats, which is indexed by round - 1 and grown as needed.
+void simulate_game(const SimulationParameters &parameters, unsigned int seed, std::vector<RoundStats> &stats);
+}// namespace minesweeper
+
+#endif
@@ -1,4 +1,5 @@
 #include "board.h"
+#include <algorithm>
 #include <catch2/catch.hpp>
 
 void check_default_render(const minesweeper::Board &board)
@@ -146,4 +147,143 @@ TEST_CASE("Reveal neighbors right click", "[board]")
   board.on_right_click(click_row, click_col);
   REQUIRE(board.is_alive());
   REQUIRE(board.is_complete());
-}
\ No newline at end of file
+}
+TEST_CASE("Seeded boards", "[board]")
+{
+  minesweeper::Board first{ 8, 8, 10, 42 };// NOLINT magic numbers
+  minesweeper::Board second{ 8, 8, 10, 42 };// NOLINT magic numbers
+  std::vector<std::uint8_t> first_cells(64);
+  std::vector<std::uint8_t> second_cells(64);
+  first.encode(first_cells);
+  second.encode(second_cells);
+  REQUIRE(first_cells == second_cells);
+}
+
+TEST_CASE("Read tiles", "[board]")
+{
+  minesweeper::Board board{ 2, 2, 4 };
+  REQUIRE(minesweeper::read_tile(board.render().get(0, 0)).state == minesweeper::TileState::covered);
+  board.on_right_click(0, 0);
+  REQUIRE(minesweeper::read_tile(board.render().get(0, 0)).state == minesweeper::TileState::flagged);
+  board.on_left_click(1, 1);
+  REQUIRE(minesweeper::read_tile(board.render().get(1, 1)).state == minesweeper::TileState::detonated);
+
+  minesweeper::Board one{ 1, 2, 1 };
+  const auto [mine_row, mine_col] = find_mine(one);
+  one.restore();
+  one.on_left_click(0, 1 - mine_col);
+  auto tile = minesweeper::read_tile(one.render().get(mine_row, 1 - mine_col));
+  REQUIRE(tile.state == minesweeper::TileState::revealed);
+  REQUIRE(tile.adjacentMines == 1);
+
+  const std::vector<std::uint8_t> encoded{ 1, 1, 1, 4 };// three mines around a revealed 3, which is drawn in red
+  minesweeper::Board three{ 2, 2, 3, encoded };
+  tile = minesweeper::read_tile(three.render().get(1, 1));
+  REQUIRE(tile.state == minesweeper::TileState::revealed);
+  REQUIRE(tile.adjacentMines == 3);
+}
+
+namespace {
+// Clicks every tile of a board: left clicks on safe tiles and right clicks on mines, in a shuffled order.
+std::vector<minesweeper::Click> solving_clicks(const minesweeper::Board &board, unsigned int seed)
+{
+  std::vector<std::uint8_t> encoded(static_cast<std::size_t>(board.get_rows() * board.get_columns()));
+  board.encode(encoded);
+  std::vector<minesweeper::Click> clicks;
+  for (int r = 0; r < board.get_rows(); r++) {
+    for (int c = 0; c < board.get_columns(); c++) {
+      clicks.push_back({ r, c, (encoded[static_cast<std::size_t>(r * board.get_columns() + c)] & 1U) != 0 });
+    }
+  }
+  std::shuffle(clicks.begin(), clicks.end(), std::mt19937{ seed });
+  return clicks;
+}
+
+// Applies clicks one at a time, checking the board after each one as callers of the single click events do.
+minesweeper::ClickResult click_one_by_one(minesweeper::Board &board, std::span<const minesweeper::Click> clicks)
+{
+  minesweeper::ClickResult result{ 0, 0, board.is_alive(), board.is_complete() };
+  for (const auto &click : clicks) {
+    if (!result.alive) { break; }
+    result.applied++;
+    if (click.right) {
+      board.on_right_click(click.row, click.col);
+    } else {
+      board.on_left_click(click.row, click.col);
+    }
+    result.alive = board.is_alive();
+    result.complete = board.is_complete();
+  }
+  return result;
+}
+
+std::vector<std::uint8_t> encode(const minesweeper::Board &board)
+{
+  std::vector<std::uint8_t> encoded(static_cast<std::size_t>(board.get_rows() * board.get_columns()));
+  board.encode(encoded);
+  return encoded;
+}
+}// namespace
+
+TEST_CASE("Batch clicks match single clicks", "[board]")
+{
+  for (unsigned int seed = 1; seed <= 50; seed++) {// NOLINT magic numbers
+    minesweeper::Board single{ 9, 9, 10, seed };// NOLINT magic numbers
+    minesweeper::Board batch{ 9, 9, 10, seed };// NOLINT magic numbers
+    std::mt19937 random{ seed };
+    std::uniform_int_distribution<int> cell{ 0, 8 };// NOLINT magic numbers
+    std::vector<minesweeper::Click> clicks;
+    for (int i = 0; i < 40; i++) { clicks.push_back({ cell(random), cell(random), random() % 4 == 0 }); }// NOLINT
+
+    auto expected = click_one_by_one(single, clicks);
+    auto result = batch.on_clicks(clicks);
+    REQUIRE(result.applied == expected.applied);
+    REQUIRE(result.alive == expected.alive);
+    REQUIRE(result.complete == expected.complete);
+    REQUIRE(encode(batch) == encode(single));
+  }
+}
+
+TEST_CASE("Batch clicks stop at the first detonation", "[board]")
+{
+  minesweeper::Board board{ 1, 3, 1, 1 };
+  auto clicks = solving_clicks(board, 1);
+  for (auto &click : clicks) { click.right = false; }
+  auto result = board.on_clicks(clicks);
+  REQUIRE_FALSE(result.alive);
+  REQUIRE_FALSE(board.is_alive());
+  const auto &last = clicks.at(result.applied - 1);
+  REQUIRE((encode(board).at(static_cast<std::size_t>(last.col)) & 1U) == 1U);
+  REQUIRE(result.revealed == static_cast<int>(result.applied));
+
+  REQUIRE(board.on_clicks(clicks).applied == 0);
+}
+
+TEST_CASE("Batch clicks solve a board", "[board]")
+{
+  minesweeper::Board board{ 16, 30, 99, 1 };// NOLINT magic numbers
+  auto result = board.on_clicks(solving_clicks(board, 1));
+  REQUIRE(result.alive);
+  REQUIRE(result.complete);
+  REQUIRE(result.revealed == 16 * 30 - 99);
+  REQUIRE(board.is_complete());
+  REQUIRE(board.on_clicks({}).complete);
+}
+
+TEST_CASE("Batch click throughput", "[.][benchmark]")
+{
+  const minesweeper::Board board{ 50, 50, 400, 1 };// NOLINT magic numbers
+  const auto clicks = solving_clicks(board, 1);
+
+  BENCHMARK("single clicks")
+  {
+    auto copy = board;
+    return click_one_by_one(copy, clicks).complete;
+  };
+
+  BENCHMARK("batch clicks")
+  {
+    auto copy = board;
+    return copy.on_clicks(clicks).complete;
+  };
+}
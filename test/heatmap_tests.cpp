@@ -0,0 +1,274 @@
+#include "bot.h"
+#include "heatmap.h"
+#include <atomic>
+#include <bit>
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace {
+// Reads tiles from rows of text: '.' is covered, 'F' is flagged, and digits are revealed numbers.
+std::vector<minesweeper::Tile> parse_tiles(const std::vector<std::string> &rows)
+{
+  std::vector<minesweeper::Tile> tiles;
+  for (const auto &row : rows) {
+    for (auto c : row) {
+      if (c == '.') {
+        tiles.push_back({ minesweeper::TileState::covered, 0 });
+      } else if (c == 'F') {
+        tiles.push_back({ minesweeper::TileState::flagged, 0 });
+      } else {
+        tiles.push_back({ minesweeper::TileState::revealed, c - '0' });
+      }
+    }
+  }
+  return tiles;
+}
+
+std::vector<minesweeper::Tile> read_tiles(const minesweeper::Bitmap &bitmap)
+{
+  std::vector<minesweeper::Tile> tiles;
+  for (int r = 0; r < bitmap.get_rows(); r++) {
+    for (int c = 0; c < bitmap.get_columns(); c++) { tiles.push_back(minesweeper::read_tile(bitmap.get(r, c))); }
+  }
+  return tiles;
+}
+
+// Computes mine probabilities by trying every placement of the remaining mines among the covered tiles.
+std::vector<double>
+  brute_force(const std::vector<minesweeper::Tile> &tiles, int rows, int columns, int mines)// NOLINT adj int params
+{
+  std::vector<int> covered;
+  int flags = 0;
+  for (int i = 0; i < rows * columns; i++) {
+    auto state = tiles[static_cast<std::size_t>(i)].state;
+    if (state == minesweeper::TileState::covered) { covered.push_back(i); }
+    if (state == minesweeper::TileState::flagged) { flags++; }
+  }
+  std::vector<double> counts(tiles.size(), 0.0);
+  double total = 0;
+  std::vector<char> mine(tiles.size(), 0);
+  for (unsigned int mask = 0; mask < 1U << covered.size(); mask++) {
+    if (std::popcount(mask) != mines - flags) { continue; }
+    for (std::size_t i = 0; i < tiles.size(); i++) {
+      mine[i] = tiles[i].state == minesweeper::TileState::flagged ? 1 : 0;
+    }
+    for (std::size_t i = 0; i < covered.size(); i++) {
+      if ((mask >> i & 1U) != 0) { mine[static_cast<std::size_t>(covered[i])] = 1; }
+    }
+    auto consistent = true;
+    for (int row = 0; row < rows; row++) {
+      for (int col = 0; col < columns; col++) {
+        const auto &tile = tiles[static_cast<std::size_t>(row * columns + col)];
+        if (tile.state != minesweeper::TileState::revealed) { continue; }
+        int adjacent = 0;
+        for (int r = std::max(0, row - 1); r <= std::min(rows - 1, row + 1); r++) {
+          for (int c = std::max(0, col - 1); c <= std::min(columns - 1, col + 1); c++) {
+            adjacent += mine[static_cast<std::size_t>(r * columns + c)];
+          }
+        }
+        consistent = consistent && adjacent == tile.adjacentMines;
+      }
+    }
+    if (!consistent) { continue; }
+    total += 1;
+    for (auto cell : covered) { counts[static_cast<std::size_t>(cell)] += mine[static_cast<std::size_t>(cell)]; }
+  }
+  for (auto &count : counts) { count /= total; }
+  return counts;
+}
+
+bool equal(float probability, double expected) { return std::abs(static_cast<double>(probability) - expected) < 1e-4; }
+}// namespace
+
+TEST_CASE("Solve a certain mine", "[heatmap]")
+{
+  minesweeper::ProbabilitySolver solver;
+  std::vector<float> probabilities;
+  solver.solve(parse_tiles({ "1.." }), 1, 3, 1, probabilities);
+  REQUIRE(probabilities[0] == minesweeper::UNKNOWN_PROBABILITY);
+  REQUIRE(equal(probabilities[1], 1.0));
+  REQUIRE(equal(probabilities[2], 0.0));
+}
+
+TEST_CASE("Solve weighs the frontier against the mine count", "[heatmap]")
+{
+  minesweeper::ProbabilitySolver solver;
+  std::vector<float> probabilities;
+  solver.solve(parse_tiles({ ".1.." }), 1, 4, 1, probabilities);
+  REQUIRE(equal(probabilities[0], 0.5));
+  REQUIRE(equal(probabilities[2], 0.5));
+  REQUIRE(equal(probabilities[3], 0.0));
+
+  solver.solve(parse_tiles({ ".1.." }), 1, 4, 2, probabilities);
+  REQUIRE(equal(probabilities[0], 0.5));
+  REQUIRE(equal(probabilities[2], 0.5));
+  REQUIRE(equal(probabilities[3], 1.0));
+}
+
+TEST_CASE("Solve an untouched board", "[heatmap]")
+{
+  minesweeper::ProbabilitySolver solver;
+  std::vector<float> probabilities;
+  solver.solve(parse_tiles({ ".....", "....." }), 2, 5, 3, probabilities);
+  for (auto probability : probabilities) { REQUIRE(equal(probability, 0.3)); }
+}
+
+TEST_CASE("Solve a contradictory board", "[heatmap]")
+{
+  minesweeper::ProbabilitySolver solver;
+  std::vector<float> probabilities;
+  solver.solve(parse_tiles({ "F0.." }), 1, 4, 2, probabilities);
+  for (auto probability : probabilities) { REQUIRE(probability == minesweeper::UNKNOWN_PROBABILITY); }
+}
+
+TEST_CASE("Solve matches brute force", "[heatmap]")
+{
+  for (unsigned int seed = 1; seed <= 40; seed++) {// NOLINT magic numbers
+    minesweeper::Board board{ 4, 4, 4, seed };
+    board.on_left_click(static_cast<int>(seed % 4), static_cast<int>(seed / 4 % 4));
+    if (seed % 3 == 0) { board.on_right_click(static_cast<int>(seed / 2 % 4), static_cast<int>(seed % 4)); }
+    if (!board.is_alive()) { continue; }
+    auto tiles = read_tiles(board.render());
+    minesweeper::ProbabilitySolver solver;
+    std::vector<float> probabilities;
+    solver.solve(tiles, 4, 4, 4, probabilities);
+    auto expected = brute_force(tiles, 4, 4, 4);
+    for (std::size_t i = 0; i < tiles.size(); i++) {
+      if (tiles[i].state == minesweeper::TileState::covered) {
+        REQUIRE(equal(probabilities[i], expected[i]));
+      } else {
+        REQUIRE(probabilities[i] == minesweeper::UNKNOWN_PROBABILITY);
+      }
+    }
+  }
+}
+
+TEST_CASE("Solve enumerates changed components only", "[heatmap]")
+{
+  minesweeper::ProbabilitySolver solver;
+  std::vector<float> probabilities;
+  solver.solve(parse_tiles({ "..1...1.." }), 1, 9, 3, probabilities);// NOLINT magic numbers
+  REQUIRE(solver.get_enumerated() == 2);
+  solver.solve(parse_tiles({ "..1...1.." }), 1, 9, 3, probabilities);// NOLINT magic numbers
+  REQUIRE(solver.get_enumerated() == 0);
+  solver.solve(parse_tiles({ "F.1...1.." }), 1, 9, 3, probabilities);// NOLINT magic numbers
+  REQUIRE(solver.get_enumerated() == 0);
+  solver.solve(parse_tiles({ "F.1...1.1" }), 1, 9, 3, probabilities);// NOLINT magic numbers
+  REQUIRE(solver.get_enumerated() == 1);
+  REQUIRE(equal(probabilities[5], 0.0));// NOLINT magic numbers
+  REQUIRE(equal(probabilities[7], 1.0));// NOLINT magic numbers
+}
+
+TEST_CASE("Solve a large board", "[heatmap]")
+{
+  minesweeper::Board board{ 100, 100, 1500, 1 };// NOLINT magic numbers
+  minesweeper::Bot bot{ 1 };
+  for (int turn = 0; turn < 20 && board.is_alive(); turn++) {// NOLINT magic numbers
+    for (const auto &move : bot.next(board.render())) {
+      if (move.flag) {
+        board.on_right_click(move.row, move.col);
+      } else {
+        board.on_left_click(move.row, move.col);
+      }
+    }
+    if (!board.is_alive()) { board.restore(); }
+  }
+  auto tiles = read_tiles(board.render());
+  minesweeper::ProbabilitySolver solver;
+  std::vector<float> probabilities;
+  solver.solve(tiles, 100, 100, 1500, probabilities);// NOLINT magic numbers
+  REQUIRE(solver.get_enumerated() > 0);
+  for (std::size_t i = 0; i < tiles.size(); i++) {
+    if (tiles[i].state == minesweeper::TileState::covered) {
+      REQUIRE(probabilities[i] >= 0);
+      REQUIRE(probabilities[i] <= 1);
+    }
+  }
+  solver.solve(tiles, 100, 100, 1500, probabilities);// NOLINT magic numbers
+  REQUIRE(solver.get_enumerated() == 0);
+}
+
+TEST_CASE("Heatmap colors covered tiles", "[heatmap]")
+{
+  minesweeper::Bitmap bitmap{ 1, 4 };
+  bitmap.set(0, 0, { minesweeper::Color::blue, minesweeper::Color::white, '1' });
+  for (int col = 1; col < 4; col++) {
+    bitmap.set(0, col, { minesweeper::Color::light_gray, minesweeper::Color::light_gray, ' ' });
+  }
+  bitmap.set(0, 3, { minesweeper::Color::light_gray, minesweeper::Color::dark_gray, ' ' });// NOLINT hovered
+
+  minesweeper::Heatmap heatmap;
+  heatmap.update(bitmap, 1);
+  heatmap.update(bitmap, 1);
+  REQUIRE(heatmap.get_submitted() == 1);
+  for (int i = 0; i < 500 && heatmap.get_published() != heatmap.get_submitted(); i++) {// NOLINT magic numbers
+    std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });// NOLINT magic numbers
+  }
+  REQUIRE(heatmap.get_published() == 1);
+
+  heatmap.overlay(bitmap);
+  REQUIRE(bitmap.get(0, 0).background == minesweeper::Color::white);
+  REQUIRE(bitmap.get(0, 1).background == minesweeper::Color::black);
+  REQUIRE(bitmap.get(0, 2).background == minesweeper::Color::green);
+  REQUIRE(bitmap.get(0, 3).background == minesweeper::Color::dark_gray);
+  REQUIRE(minesweeper::read_tile(bitmap.get(0, 1)).state == minesweeper::TileState::covered);
+}
+
+TEST_CASE("Heatmap does not color a board with an earlier result", "[heatmap]")
+{
+  minesweeper::Bitmap first{ 1, 4 };
+  minesweeper::Bitmap second{ 1, 4 };
+  for (int col = 0; col < 4; col++) {
+    first.set(0, col, { minesweeper::Color::light_gray, minesweeper::Color::light_gray, ' ' });
+    second.set(0, col, { minesweeper::Color::light_gray, minesweeper::Color::light_gray, ' ' });
+  }
+  first.set(0, 0, { minesweeper::Color::blue, minesweeper::Color::white, '1' });// tile 1 is a mine
+  second.set(0, 3, { minesweeper::Color::blue, minesweeper::Color::white, '1' });// NOLINT tile 2 is a mine
+
+  minesweeper::Heatmap heatmap;
+  heatmap.update(first, 1);
+  for (int i = 0; i < 500 && heatmap.get_published() != heatmap.get_submitted(); i++) {// NOLINT magic numbers
+    std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });// NOLINT magic numbers
+  }
+  REQUIRE(heatmap.get_published() == 1);
+
+  // Whether or not the second board is solved yet, tile 1 is never drawn with the first board's certain mine.
+  heatmap.update(second, 1);
+  heatmap.overlay(second);
+  REQUIRE(second.get(0, 1).background != minesweeper::Color::black);
+  if (second.get(0, 0).background == minesweeper::Color::light_gray) {
+    REQUIRE(second.get(0, 1).background == minesweeper::Color::light_gray);
+  } else {
+    REQUIRE(second.get(0, 1).background == minesweeper::Color::green);
+  }
+}
+
+TEST_CASE("Heatmap calls back when a result is published", "[heatmap]")
+{
+  minesweeper::Bitmap bitmap{ 1, 2 };
+  bitmap.set(0, 0, { minesweeper::Color::blue, minesweeper::Color::white, '1' });
+  bitmap.set(0, 1, { minesweeper::Color::light_gray, minesweeper::Color::light_gray, ' ' });
+
+  std::atomic<int> calls = 0;
+  minesweeper::Heatmap heatmap{ [&calls] { calls++; } };
+  heatmap.update(bitmap, 1);
+  for (int i = 0; i < 500 && calls == 0; i++) {// NOLINT magic numbers
+    std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });// NOLINT magic numbers
+  }
+  REQUIRE(calls == 1);
+  REQUIRE(heatmap.get_published() == 1);
+  heatmap.overlay(bitmap);
+  REQUIRE(bitmap.get(0, 1).background == minesweeper::Color::black);
+}
+
+TEST_CASE("Heat colors", "[heatmap]")
+{
+  REQUIRE(minesweeper::heat_color(0.0F) == minesweeper::Color::green);
+  REQUIRE(minesweeper::heat_color(0.1F) == minesweeper::Color::sea_green);
+  REQUIRE(minesweeper::heat_color(0.3F) == minesweeper::Color::blue);
+  REQUIRE(minesweeper::heat_color(0.6F) == minesweeper::Color::dark_blue);
+  REQUIRE(minesweeper::heat_color(0.9F) == minesweeper::Color::dark_red);
+  REQUIRE(minesweeper::heat_color(1.0F) == minesweeper::Color::black);
+}
@@ -0,0 +1,20 @@
+#ifndef MINESWEEPER_RENDER_HELPERS
+#define MINESWEEPER_RENDER_HELPERS
+
+#include "bitmap.h"
+
+// Returns true if two rendered boards have the same dimensions and pixels. Use it inside REQUIRE.
+inline bool same_render(const minesweeper::Bitmap &expected, const minesweeper::Bitmap &actual)
+{
+  if (expected.get_rows() != actual.get_rows() || expected.get_columns() != actual.get_columns()) { return false; }
+  for (int r = 0; r < expected.get_rows(); r++) {
+    for (int c = 0; c < expected.get_columns(); c++) {
+      auto e = expected.get(r, c);
+      auto a = actual.get(r, c);
+      if (e.value != a.value || e.foreground != a.foreground || e.background != a.background) { return false; }
+    }
+  }
+  return true;
+}
+
+#endif
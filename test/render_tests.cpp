@@ -0,0 +1,116 @@
+#include "game.h"
+#include "heatmap.h"
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+// Every allocation in this test binary goes through these replacements, so a test can count the allocations made
+// between two points. Catch itself allocates, so counts are only taken around code under test. Counts are kept per
+// thread, so that the heatmap worker's solves are not charged to the rendering thread.
+namespace {
+thread_local long allocations = 0;
+}// namespace
+
+void *operator new(std::size_t size)
+{
+  allocations++;
+  if (auto *memory = std::malloc(size)) { return memory; }// NOLINT manual allocation is the point of the hook
+  throw std::bad_alloc{};
+}
+
+void *operator new(std::size_t size, const std::nothrow_t & /*tag*/) noexcept
+{
+  allocations++;
+  return std::malloc(size);// NOLINT manual allocation is the point of the hook
+}
+
+void *operator new[](std::size_t size) { return operator new(size); }
+
+void *operator new[](std::size_t size, const std::nothrow_t &tag) noexcept { return operator new(size, tag); }
+
+void operator delete(void *memory) noexcept { std::free(memory); }// NOLINT manual allocation is the point of the hook
+
+void operator delete(void *memory, std::size_t /*size*/) noexcept { operator delete(memory); }
+
+void operator delete(void *memory, const std::nothrow_t & /*tag*/) noexcept { operator delete(memory); }
+
+void operator delete[](void *memory) noexcept { operator delete(memory); }
+
+void operator delete[](void *memory, std::size_t /*size*/) noexcept { operator delete(memory); }
+
+void operator delete[](void *memory, const std::nothrow_t & /*tag*/) noexcept { operator delete(memory); }
+
+// Counts the allocations made by a function.
+template<typename Function> long count_allocations(Function function)
+{
+  auto before = allocations;
+  function();
+  return allocations - before;
+}
+
+TEST_CASE("Board frames do not allocate", "[render]")
+{
+  minesweeper::Board board{ 16, 30, 99 };// NOLINT magic numbers
+  minesweeper::Bitmap bitmap{ 0, 0 };
+  board.render(bitmap);
+
+  board.on_hover(3, 4);// NOLINT magic numbers
+  REQUIRE(count_allocations([&] { board.render(bitmap); }) == 0);
+  REQUIRE(bitmap.get(3, 4).background == minesweeper::Color::dark_gray);
+}
+
+TEST_CASE("Game frames do not allocate", "[render]")
+{
+  minesweeper::Game game{ 18, 30, 30, 20, 10, 1 };// NOLINT magic numbers
+  minesweeper::Bitmap bitmap{ 0, 0 };
+  game.render_board(bitmap);
+
+  long frame_allocations = 0;
+  for (int frame = 0; frame < 60; frame++) {// NOLINT magic numbers
+    game.on_mouse_event(frame % 18, frame % 30, false, frame % 7 == 0, true);// NOLINT magic numbers
+    game.on_refresh_event();
+    frame_allocations += count_allocations([&] { game.render_board(bitmap); });
+  }
+  REQUIRE(frame_allocations == 0);
+}
+
+TEST_CASE("Heatmap frames do not allocate on the rendering thread", "[render]")
+{
+  minesweeper::Game game{ 18, 30, 30, 20, 10, 1 };// NOLINT magic numbers
+  minesweeper::Bitmap bitmap{ 0, 0 };
+  minesweeper::Heatmap heatmap;
+  auto frame = [&] {
+    game.render_board(bitmap);
+    heatmap.update(bitmap, game.get_mines());
+    heatmap.overlay(bitmap);
+  };
+
+  // Each of the three triple-buffered inputs is sized once before frames are counted. That takes the worker picking
+  // up every warm-up submission, since a buffer only returns to the renderer once the worker has released it.
+  for (int warmup = 0; warmup < 3; warmup++) {
+    game.on_mouse_event(warmup, 0, false, true, true);// flags change the tiles
+    frame();
+    for (int i = 0; i < 500 && heatmap.get_published() != heatmap.get_submitted(); i++) {// NOLINT magic numbers
+      std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });// NOLINT magic numbers
+    }
+  }
+
+  long frame_allocations = 0;
+  for (int frame_index = 0; frame_index < 60; frame_index++) {// NOLINT magic numbers
+    game.on_mouse_event(frame_index % 18, 1 + frame_index % 29, false, true, true);// NOLINT flags change the tiles
+    frame_allocations += count_allocations(frame);
+  }
+  REQUIRE(heatmap.get_submitted() > 60);// NOLINT magic numbers
+  REQUIRE(frame_allocations == 0);
+}
+
+TEST_CASE("Shrinking a bitmap does not allocate", "[render]")
+{
+  minesweeper::Bitmap bitmap{ 18, 30 };// NOLINT magic numbers
+  REQUIRE(count_allocations([&] { bitmap.resize(9, 9); }) == 0);// NOLINT magic numbers
+  REQUIRE(count_allocations([&] { bitmap.resize(18, 30); }) == 0);// NOLINT magic numbers
+  REQUIRE(bitmap.get_rows() == 18);
+  REQUIRE(bitmap.get_columns() == 30);
+}
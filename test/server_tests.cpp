@@ -0,0 +1,227 @@
+#include "board_server.h"
+#include "net.h"
+#include "remote_game.h"
+#include "render_helpers.h"
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+// Runs a server on a background thread for the lifetime of a test.
+class ServerThread
+{
+  std::unique_ptr<minesweeper::BoardServer> server;
+  std::thread thread;
+
+public:
+  ServerThread(const std::string &address, minesweeper::Game game)
+    : server(minesweeper::BoardServer::listen(address, std::move(game)))
+  {
+    REQUIRE(server != nullptr);
+    thread = std::thread([this] { server->run(); });
+  }
+  ServerThread(const ServerThread &) = delete;
+  ServerThread(ServerThread &&) = delete;
+  ServerThread &operator=(const ServerThread &) = delete;
+  ServerThread &operator=(ServerThread &&) = delete;
+  ~ServerThread()
+  {
+    server->stop();
+    thread.join();
+  }
+  [[nodiscard]] std::string address() const { return server->address(); }
+};
+
+std::string temp_socket_address(const std::string &name)
+{
+  return "unix:" + (std::filesystem::temp_directory_path() / name).string();
+}
+
+void await_board(minesweeper::RemoteGame &game)
+{
+  while (game.is_connected() && !game.has_board()) { game.poll(-1); }
+  REQUIRE(game.has_board());
+}
+
+void await_ack(minesweeper::RemoteGame &game, std::uint32_t seq)
+{
+  while (game.is_connected() && game.get_acked() < seq) { game.poll(-1); }
+  REQUIRE(game.get_acked() == seq);
+}
+
+TEST_CASE("Move frames", "[server]")
+{
+  std::vector<std::uint8_t> bytes;
+  minesweeper::encode_move(bytes, { 7, minesweeper::Action::right_click, 3, 12 });// NOLINT magic numbers
+  minesweeper::encode_move(bytes, { 8, minesweeper::Action::new_game, 0, 0 });// NOLINT magic numbers
+
+  minesweeper::FrameReader reader;
+  reader.append(std::span{ bytes }.first(3));
+  REQUIRE_FALSE(reader.next().has_value());
+  reader.append(std::span{ bytes }.subspan(3));
+
+  auto first = minesweeper::decode_move(*reader.next());
+  REQUIRE(first.has_value());
+  REQUIRE(first->seq == 7);
+  REQUIRE(first->action == minesweeper::Action::right_click);
+  REQUIRE(first->row == 3);
+  REQUIRE(first->col == 12);
+
+  auto second = minesweeper::decode_move(*reader.next());
+  REQUIRE(second.has_value());
+  REQUIRE(second->action == minesweeper::Action::new_game);
+  REQUIRE_FALSE(reader.next().has_value());
+  REQUIRE_FALSE(reader.is_corrupt());
+}
+
+TEST_CASE("Corrupt frame", "[server]")
+{
+  minesweeper::FrameReader reader;
+  std::vector<std::uint8_t> bytes{ 0xFF, 0xFF, 0xFF, 0xFF };// NOLINT magic numbers
+  reader.append(bytes);
+  REQUIRE_FALSE(reader.next().has_value());
+  REQUIRE(reader.is_corrupt());
+}
+
+TEST_CASE("Board sizes that fit the protocol", "[server]")
+{
+  REQUIRE(minesweeper::fits_protocol(1, 1));
+  REQUIRE(minesweeper::fits_protocol(1, 65535));// NOLINT magic numbers
+  REQUIRE(minesweeper::fits_protocol(2000, 2000));// NOLINT magic numbers
+  REQUIRE_FALSE(minesweeper::fits_protocol(0, 5));
+  REQUIRE_FALSE(minesweeper::fits_protocol(5, -1));
+  REQUIRE_FALSE(minesweeper::fits_protocol(1, 65536));// NOLINT magic numbers: rows and columns are 16-bit fields
+  REQUIRE_FALSE(minesweeper::fits_protocol(4000, 4000));// NOLINT magic numbers: the board exceeds one frame
+}
+
+TEST_CASE("Partial frames stay buffered", "[server]")
+{
+  minesweeper::FrameReader reader;
+  std::vector<std::uint8_t> bytes{ 0x02, 0x00, 0x00, 0x00, 0x01 };// NOLINT magic numbers
+  reader.append(bytes);
+  REQUIRE_FALSE(reader.next().has_value());
+  REQUIRE(reader.get_buffered() == 5);// NOLINT magic numbers
+  reader.append(std::vector<std::uint8_t>{ 0x02 });
+  REQUIRE(reader.next().has_value());
+  REQUIRE(reader.get_buffered() == 0);
+}
+
+TEST_CASE("Board diff frames", "[server]")
+{
+  minesweeper::Board board{ 3, 3, 1 };
+  auto before = board.render();
+  board.on_right_click(1, 1);
+  auto after = board.render();
+
+  std::vector<minesweeper::CellUpdate> updates;
+  minesweeper::diff_bitmaps(before, after, updates);
+  REQUIRE(updates.size() == 1);
+  REQUIRE(updates[0].row == 1);
+  REQUIRE(updates[0].col == 1);
+
+  std::vector<std::uint8_t> bytes;
+  minesweeper::encode_board(bytes, { 1, 30, 1 }, before);// NOLINT magic numbers
+  minesweeper::encode_diff(bytes, { 1, 29, 1 }, updates);// NOLINT magic numbers
+  minesweeper::FrameReader reader;
+  reader.append(bytes);
+
+  auto board_payload = *reader.next();
+  auto mirror = minesweeper::decode_board(board_payload);
+  REQUIRE(mirror.has_value());
+  REQUIRE(same_render(before, *mirror));
+
+  auto diff_payload = *reader.next();
+  REQUIRE(minesweeper::apply_diff(diff_payload, *mirror));
+  REQUIRE(same_render(after, *mirror));
+  REQUIRE(minesweeper::decode_status(diff_payload)->time == 29);
+}
+
+TEST_CASE("Clients share a board over a unix socket", "[server]")
+{
+  ServerThread server{ temp_socket_address("minesweeper_server_tests.sock"), minesweeper::Game{ 4, 4, 30, 20, 2, 1 } };
+
+  auto alice = minesweeper::RemoteGame::connect(server.address());
+  auto bob = minesweeper::RemoteGame::connect(server.address());
+  REQUIRE(alice != nullptr);
+  REQUIRE(bob != nullptr);
+  await_board(*alice);
+  await_board(*bob);
+
+  auto seq = alice->send(minesweeper::Action::right_click, 2, 3);
+  await_ack(*alice, seq);
+  REQUIRE(alice->render_board().get(2, 3).value == '*');
+
+  while (bob->render_board().get(2, 3).value != '*') { REQUIRE(bob->poll(-1)); }
+  REQUIRE(same_render(alice->render_board(), bob->render_board()));
+  REQUIRE(bob->get_mines() == 2);
+}
+
+TEST_CASE("Client with oversized input is dropped", "[server]")
+{
+  ServerThread server{ temp_socket_address("minesweeper_flood_tests.sock"), minesweeper::Game{ 2, 2, 30, 20, 1, 1 } };
+
+  // a frame header announcing a long but valid payload, followed by more input than any move
+  std::vector<std::uint8_t> bytes(1U << 17U);// NOLINT magic numbers
+  bytes[2] = 0x10;// NOLINT magic numbers
+  auto fd = minesweeper::connect_to(server.address());
+  REQUIRE(fd >= 0);
+  std::size_t sent = 0;
+  while (sent < bytes.size()) {
+    auto result = ::send(fd, bytes.data() + sent, bytes.size() - sent, MSG_NOSIGNAL);
+    if (result <= 0) { break; }
+    sent += static_cast<std::size_t>(result);
+  }
+
+  std::array<std::uint8_t, 4096> discard{};// NOLINT magic numbers
+  while (::recv(fd, discard.data(), discard.size(), 0) > 0) {}
+  ::close(fd);
+
+  auto game = minesweeper::RemoteGame::connect(server.address());
+  REQUIRE(game != nullptr);
+  await_board(*game);
+}
+
+TEST_CASE("Client hover stays local", "[server]")
+{
+  ServerThread server{ temp_socket_address("minesweeper_hover_tests.sock"), minesweeper::Game{ 2, 2, 30, 20, 1, 1 } };
+
+  auto game = minesweeper::RemoteGame::connect(server.address());
+  REQUIRE(game != nullptr);
+  await_board(*game);
+  game->on_mouse_event(0, 0, false, false, false);
+  REQUIRE(game->render_board().get(0, 0).background == minesweeper::Color::dark_gray);
+  REQUIRE(game->render_board().get(1, 1).background == minesweeper::Color::light_gray);
+}
+
+TEST_CASE("Many clients over tcp", "[server]")
+{
+  constexpr int clients = 200;
+  constexpr int moves = 5;
+  ServerThread server{ "tcp:0", minesweeper::Game{ 16, 30, 30, 20, 99, 1 } };// NOLINT magic numbers
+
+  std::vector<std::unique_ptr<minesweeper::RemoteGame>> games;
+  for (int i = 0; i < clients; i++) {
+    games.push_back(minesweeper::RemoteGame::connect(server.address()));
+    REQUIRE(games.back() != nullptr);
+    await_board(*games.back());
+  }
+
+  std::vector<std::uint32_t> seqs(games.size());
+  for (int move = 0; move < moves; move++) {
+    for (std::size_t i = 0; i < games.size(); i++) {
+      seqs[i] = games[i]->send(minesweeper::Action::right_click, static_cast<int>(i) % 16, move);// NOLINT
+    }
+    for (std::size_t i = 0; i < games.size(); i++) { await_ack(*games[i], seqs[i]); }
+  }
+
+  // every client has applied every diff preceding its own final ack; drain the rest and compare
+  auto last = games.back()->send(minesweeper::Action::right_click, 15, 29);// NOLINT magic numbers
+  await_ack(*games.back(), last);
+  for (auto &game : games) {
+    while (game->render_board().get(15, 29).value != games.back()->render_board().get(15, 29).value) {// NOLINT
+      REQUIRE(game->poll(-1));
+    }
+    REQUIRE(same_render(games.back()->render_board(), game->render_board()));
+  }
+}
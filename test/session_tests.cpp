@@ -0,0 +1,118 @@
+#include "render_helpers.h"
+#include "session.h"
+#include <catch2/catch.hpp>
+#include <cstring>
+#include <filesystem>
+
+std::string temp_session_path(const std::string &name)
+{
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+TEST_CASE("Encode and decode session", "[session]")
+{
+  minesweeper::Game game{ 3, 4, 30, 20, 2, 1 };// NOLINT magic numbers
+  game.on_mouse_event(0, 0, false, true, true);
+  game.on_mouse_event(-1, -1, false, false, false);
+
+  auto image = minesweeper::encode_session(game);
+  REQUIRE(image.size() == sizeof(minesweeper::SessionHeader) + 12);
+
+  auto restored = minesweeper::decode_session(image);
+  REQUIRE(restored.has_value());
+  REQUIRE(restored->get_round() == game.get_round());
+  REQUIRE(restored->get_time() == game.get_time());
+  REQUIRE(restored->get_mines() == game.get_mines());
+  REQUIRE(same_render(game.render_board(), restored->render_board()));
+  REQUIRE(restored->render_board().get(0, 0).value == '*');
+}
+
+TEST_CASE("Resume game in progress", "[session]")
+{
+  minesweeper::Game game{ 2, 2, 30, 20, 0, 0 };// NOLINT magic numbers
+  game.on_mouse_event(0, 0, true, false, true);
+  REQUIRE(game.get_round() == 2);
+
+  auto restored = minesweeper::decode_session(minesweeper::encode_session(game));
+  REQUIRE(restored.has_value());
+  REQUIRE(restored->get_round() == 2);
+  REQUIRE(restored->get_time() == game.get_time());
+}
+
+TEST_CASE("Reject invalid session", "[session]")
+{
+  minesweeper::Game game{ 2, 2, 5, 5, 1, 1 };// NOLINT magic numbers
+  auto image = minesweeper::encode_session(game);
+
+  REQUIRE_FALSE(minesweeper::decode_session(std::span{ image }.first(image.size() - 1)).has_value());
+
+  auto bad_magic = image;
+  bad_magic[0] = 'X';
+  REQUIRE_FALSE(minesweeper::decode_session(bad_magic).has_value());
+
+  REQUIRE_FALSE(minesweeper::decode_session({}).has_value());
+}
+
+TEST_CASE("Reject inconsistent session header", "[session]")
+{
+  minesweeper::Game game{ 2, 2, 5, 5, 1, 1 };// NOLINT magic numbers
+  auto image = minesweeper::encode_session(game);
+  auto with_header = [&image](auto change) {
+    minesweeper::SessionHeader header{};
+    std::memcpy(&header, image.data(), sizeof(header));
+    change(header);
+    auto changed = image;
+    std::memcpy(changed.data(), &header, sizeof(header));
+    return changed;
+  };
+
+  REQUIRE(minesweeper::decode_session(with_header([](auto &) {})).has_value());
+  REQUIRE_FALSE(minesweeper::decode_session(with_header([](auto &header) { header.mines = 5; })).has_value());
+  REQUIRE_FALSE(minesweeper::decode_session(with_header([](auto &header) { header.mines = 2; })).has_value());
+  REQUIRE_FALSE(minesweeper::decode_session(with_header([](auto &header) { header.round = 0; })).has_value());
+  REQUIRE_FALSE(minesweeper::decode_session(with_header([](auto &header) { header.mines_init = 5; })).has_value());
+  REQUIRE_FALSE(minesweeper::decode_session(with_header([](auto &header) { header.mines_init = -1; })).has_value());
+  REQUIRE_FALSE(
+    minesweeper::decode_session(with_header([](auto &header) { header.mines_increment = -1; })).has_value());
+  REQUIRE_FALSE(minesweeper::decode_session(with_header([](auto &header) { header.time_init = 0; })).has_value());
+  REQUIRE_FALSE(minesweeper::decode_session(with_header([](auto &header) {
+    header.rows = 65536;// NOLINT magic numbers: the cell count overflows an int
+    header.columns = 65536;// NOLINT magic numbers
+  })).has_value());
+}
+
+TEST_CASE("Save and load session file", "[session]")
+{
+  auto path = temp_session_path("minesweeper_session_tests.session");
+  std::filesystem::remove(path);
+  REQUIRE_FALSE(minesweeper::load_session(path).has_value());
+
+  minesweeper::Game game{ 16, 30, 30, 20, 99, 1 };// NOLINT magic numbers
+  game.on_mouse_event(5, 7, false, true, true);// NOLINT magic numbers
+  game.on_mouse_event(-1, -1, false, false, false);
+  REQUIRE(minesweeper::save_session(path, game));
+  REQUIRE_FALSE(std::filesystem::exists(path + ".tmp"));
+
+  auto loaded = minesweeper::load_session(path);
+  REQUIRE(loaded.has_value());
+  REQUIRE(loaded->get_mines() == 99);
+  REQUIRE(same_render(game.render_board(), loaded->render_board()));
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("Checkpoint session in background", "[session]")
+{
+  auto path = temp_session_path("minesweeper_checkpoint_tests.session");
+  std::filesystem::remove(path);
+
+  minesweeper::Game game{ 4, 4, 30, 20, 3, 1 };// NOLINT magic numbers
+  {
+    minesweeper::SessionCheckpointer checkpointer{ path, std::chrono::milliseconds{ 0 } };
+    checkpointer.on_refresh(game);
+  }// destruction flushes the pending checkpoint
+
+  auto loaded = minesweeper::load_session(path);
+  REQUIRE(loaded.has_value());
+  REQUIRE(same_render(game.render_board(), loaded->render_board()));
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,100 @@
+#include "bot.h"
+#include "simulation.h"
+#include <catch2/catch.hpp>
+
+TEST_CASE("Bot clears an empty board", "[simulation]")
+{
+  minesweeper::Board board{ 4, 4, 0 };
+  minesweeper::Bot bot{ 1 };
+  const auto &moves = bot.next(board.render());
+  REQUIRE(moves.size() == 1);
+  REQUIRE_FALSE(moves[0].flag);
+  board.on_left_click(moves[0].row, moves[0].col);
+  REQUIRE(board.is_complete());
+  REQUIRE(bot.next(board.render()).empty());
+}
+
+TEST_CASE("Bot flags a certain mine", "[simulation]")
+{
+  minesweeper::Board board{ 1, 2, 1 };
+  minesweeper::Bot bot{ 1 };
+  for (int col = 0; col < 2; col++) {
+    board.restore();
+    board.on_left_click(0, col);
+    if (board.is_alive()) {
+      const auto &moves = bot.next(board.render());
+      REQUIRE(moves.size() == 1);
+      REQUIRE(moves[0].flag);
+      REQUIRE(moves[0].col == 1 - col);
+      return;
+    }
+  }
+  FAIL("no safe tile found");
+}
+
+TEST_CASE("Bot remembers detonated mines", "[simulation]")
+{
+  minesweeper::Board board{ 2, 2, 4 };
+  minesweeper::Bot bot{ 1 };
+  REQUIRE(bot.next(board.render()).size() == 1);// a guess, since nothing is known yet
+  bot.on_detonation(1, 0);
+  const auto &moves = bot.next(board.render());
+  REQUIRE_FALSE(moves.empty());
+  REQUIRE(moves[0].row == 1);
+  REQUIRE(moves[0].col == 0);
+  REQUIRE(moves[0].flag);
+}
+
+TEST_CASE("Bot guesses independently of a board with the same seed", "[simulation]")
+{
+  int detonations = 0;
+  for (unsigned int seed = 0; seed < 20; seed++) {// NOLINT magic numbers
+    minesweeper::Board board{ 10, 10, 20, seed };// NOLINT magic numbers
+    minesweeper::Bot bot{ seed };
+    const auto &moves = bot.next(board.render());
+    board.on_left_click(moves[0].row, moves[0].col);
+    if (!board.is_alive()) { detonations++; }
+  }
+  REQUIRE(detonations < 20);
+}
+
+TEST_CASE("Simulated games are reproducible", "[simulation]")
+{
+  minesweeper::SimulationParameters parameters{ 9, 9, 30, 20, 10, 1, 0.5, 20 };// NOLINT magic numbers
+  std::vector<minesweeper::RoundStats> first;
+  std::vector<minesweeper::RoundStats> second;
+  for (unsigned int seed = 0; seed < 20; seed++) {// NOLINT magic numbers
+    minesweeper::simulate_game(parameters, seed, first);
+    minesweeper::simulate_game(parameters, seed, second);
+  }
+  REQUIRE(first.size() == second.size());
+  REQUIRE(first[0].reached == 20);
+  for (std::size_t i = 0; i < first.size(); i++) {
+    REQUIRE(first[i].reached == second[i].reached);
+    REQUIRE(first[i].solved == second[i].solved);
+    REQUIRE(first[i].deaths == second[i].deaths);
+  }
+}
+
+TEST_CASE("Unlimited time reaches the round limit", "[simulation]")
+{
+  minesweeper::SimulationParameters parameters{ 5, 5, 1000000, 0, 0, 0, 1.0, 10 };// NOLINT magic numbers
+  std::vector<minesweeper::RoundStats> stats;
+  minesweeper::simulate_game(parameters, 7, stats);// NOLINT magic numbers
+  REQUIRE(stats.size() == 10);
+  for (const auto &round : stats) {
+    REQUIRE(round.reached == 1);
+    REQUIRE(round.solved == 1);
+    REQUIRE(round.solve_seconds == 1.0);
+  }
+}
+
+TEST_CASE("Expired time ends the game", "[simulation]")
+{
+  minesweeper::SimulationParameters parameters{ 16, 30, 1, 0, 99, 0, 2.0, 10 };// NOLINT magic numbers
+  std::vector<minesweeper::RoundStats> stats;
+  minesweeper::simulate_game(parameters, 3, stats);// NOLINT magic numbers
+  REQUIRE(stats.size() == 1);
+  REQUIRE(stats[0].reached == 1);
+  REQUIRE(stats[0].solved == 0);
+}